@@ -0,0 +1,474 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/benchmark/structure_serialization_benchmark.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * Benchmark for serialization and deserialization of structure information.
+ *
+ * Creates a synthetic framework element tree and measures time, bytes and
+ * heap allocations per element for tFrameworkElementInfo::Serialize (all structure
+ * exchange levels), tFrameworkElementInfo::Deserialize (also to a string pool and
+ * a columnar table), SerializeConnections and the tNetworkConnections stream
+ * operators - each with the original format and with all optional encodings
+ * of this implementation.
+ *
+ * Usage: structure_serialization_benchmark [--elements N] [--depth N] [--links N] [--fan-out N] [--network-connections N] [--iterations N]
+ *
+ * With --fan-out, every output port is connected to N distinct input ports
+ * (e.g. --fan-out 300 for connection lists that exceed the original format's limit of 254 connections).
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "core/tRuntimeEnvironment.h"
+#include "plugins/data_ports/tInputPort.h"
+#include "plugins/data_ports/tOutputPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkConnections.h"
+#include "plugins/network_transport/tProtocolCapabilities.h"
+#include "plugins/network_transport/structure_info/tFrameworkElementInfo.h"
+#include "plugins/network_transport/structure_info/tPooledFrameworkElementInfo.h"
+#include "plugins/network_transport/structure_info/tRemoteStructureTable.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc;
+using namespace finroc::network_transport;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Number of ports in each leaf group of the synthetic tree (half of them outputs - more inputs are added if fan-out exceeds the other half) */
+static const size_t cPORTS_PER_GROUP = 20;
+
+/*! Number of child groups of each inner group of the synthetic tree */
+static const size_t cBRANCHING_FACTOR = 4;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+/*! Number of heap allocations performed by this process */
+std::atomic<size_t> allocation_count(0);
+
+/*! Benchmark parameters */
+struct tOptions
+{
+  size_t elements = 10000;
+  size_t depth = 4;
+  size_t links = 0;
+  size_t fan_out = 1;
+  size_t network_connections = 0;
+  size_t iterations = 5;
+};
+
+/*! Result of a single benchmark */
+struct tMeasurement
+{
+  double ns_per_element;
+  double bytes_per_element;
+  double allocations_per_element;
+};
+
+/*! Synthetic framework element tree */
+struct tTree
+{
+  /*! All framework elements (groups and ports) */
+  std::vector<core::tFrameworkElement*> elements;
+
+  /*! All ports (shared) */
+  std::vector<core::tFrameworkElement*> ports;
+
+  /*! All output ports */
+  std::vector<core::tAbstractPort*> output_ports;
+
+  /*! All network connection annotations */
+  std::vector<tNetworkConnections*> network_connections;
+};
+
+bool ParseOptions(int argc, char** argv, tOptions& options)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc)
+    {
+      return false;
+    }
+    size_t value = static_cast<size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+    if (std::strcmp(argv[i], "--elements") == 0)
+    {
+      options.elements = value;
+    }
+    else if (std::strcmp(argv[i], "--depth") == 0)
+    {
+      options.depth = std::max<size_t>(1, value);
+    }
+    else if (std::strcmp(argv[i], "--links") == 0)
+    {
+      options.links = std::min<size_t>(value, tFrameworkElementInfo::cMAX_LINKS - 1);
+    }
+    else if (std::strcmp(argv[i], "--fan-out") == 0)
+    {
+      options.fan_out = value;
+    }
+    else if (std::strcmp(argv[i], "--network-connections") == 0)
+    {
+      options.network_connections = value;
+    }
+    else if (std::strcmp(argv[i], "--iterations") == 0)
+    {
+      options.iterations = std::max<size_t>(1, value);
+    }
+    else
+    {
+      return false;
+    }
+    i++;
+  }
+  return true;
+}
+
+/*!
+ * Creates synthetic framework element tree below specified root element
+ */
+void CreateTree(core::tFrameworkElement& root, const tOptions& options, tTree& tree)
+{
+  size_t group_count = std::max<size_t>(1, options.elements / (cPORTS_PER_GROUP + 1));
+  std::vector<std::vector<core::tFrameworkElement*>> groups_per_level(options.depth);
+  core::tFrameworkElement* link_group = new core::tFrameworkElement(&root, "Links");
+  tree.elements.push_back(link_group);
+
+  for (size_t group_index = 0; group_index < group_count; group_index++)
+  {
+    // Create path of groups to leaf group (upper levels are shared among leaf groups)
+    core::tFrameworkElement* parent = &root;
+    for (size_t level = 0; level < options.depth; level++)
+    {
+      size_t divisor = 1;
+      for (size_t i = level + 1; i < options.depth; i++)
+      {
+        divisor *= cBRANCHING_FACTOR;
+      }
+      size_t index_on_level = group_index / divisor;
+      std::vector<core::tFrameworkElement*>& groups = groups_per_level[level];
+      if (index_on_level >= groups.size())
+      {
+        groups.push_back(new core::tFrameworkElement(parent, (level + 1 == options.depth ? "Module " : "Group ") + std::to_string(index_on_level)));
+        tree.elements.push_back(groups.back());
+      }
+      parent = groups[index_on_level];
+    }
+
+    // Create ports in leaf group (with enough inputs so that every output is connected to 'fan_out' distinct inputs)
+    std::vector<data_ports::tOutputPort<int>> outputs;
+    std::vector<data_ports::tInputPort<int>> inputs;
+    size_t input_count = std::max(cPORTS_PER_GROUP / 2, options.fan_out);
+    for (size_t i = 0; i < input_count; i++)
+    {
+      if (i < cPORTS_PER_GROUP / 2)
+      {
+        outputs.emplace_back("Output " + std::to_string(i), parent, core::tFrameworkElement::tFlag::SHARED);
+      }
+      inputs.emplace_back("Input " + std::to_string(i), parent, core::tFrameworkElement::tFlag::SHARED);
+    }
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+      for (size_t j = 0; j < options.fan_out; j++)
+      {
+        outputs[i].ConnectTo(inputs[(i + j) % inputs.size()]);
+      }
+    }
+
+    std::vector<core::tAbstractPort*> ports;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+      if (i < outputs.size())
+      {
+        ports.push_back(outputs[i].GetWrapped());
+        tree.output_ports.push_back(outputs[i].GetWrapped());
+      }
+      ports.push_back(inputs[i].GetWrapped());
+    }
+    for (core::tAbstractPort * port : ports)
+    {
+      for (size_t i = 0; i < options.links; i++)
+      {
+        port->Link(*link_group, "Group " + std::to_string(group_index) + " " + port->GetName() + " Link " + std::to_string(i));
+      }
+      tree.elements.push_back(port);
+      tree.ports.push_back(port);
+    }
+    for (core::tAbstractPort * port : ports)
+    {
+      if (options.network_connections)
+      {
+        tNetworkConnections* annotation = new tNetworkConnections();
+        port->AddAnnotation(annotation);
+        for (size_t i = 0; i < options.network_connections; i++)
+        {
+          annotation->Add(tNetworkConnection("benchmark-peer-" + std::to_string(i % 8) + ":4444", static_cast<core::tFrameworkElement::tHandle>(i), (i % 2) != 0));
+        }
+        tree.network_connections.push_back(annotation);
+      }
+    }
+  }
+  root.Init();
+}
+
+/*!
+ * Measures specified function (best of several iterations)
+ *
+ * \param element_count Number of elements processed per call of function
+ * \param iterations Number of iterations
+ * \param function Function to benchmark - returns number of bytes written or read
+ */
+template <typename TFunction>
+tMeasurement Measure(size_t element_count, size_t iterations, TFunction function)
+{
+  double best_ns = 0;
+  size_t bytes = 0;
+  size_t allocations = 0;
+  for (size_t i = 0; i < iterations; i++)
+  {
+    size_t allocations_before = allocation_count.load();
+    auto start = std::chrono::steady_clock::now();
+    bytes = function();
+    auto end = std::chrono::steady_clock::now();
+    allocations = allocation_count.load() - allocations_before;
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    best_ns = (i == 0) ? ns : std::min(best_ns, ns);
+  }
+  double elements = static_cast<double>(std::max<size_t>(1, element_count));
+  return tMeasurement { best_ns / elements, bytes / elements, allocations / elements };
+}
+
+void PrintMeasurement(const std::string& name, const tMeasurement& measurement)
+{
+  std::printf("%-52s %10.1f ns/element %10.1f bytes/element %8.2f allocations/element\n", name.c_str(),
+              measurement.ns_per_element, measurement.bytes_per_element, measurement.allocations_per_element);
+}
+
+const char* GetLevelName(tStructureExchange level)
+{
+  switch (level)
+  {
+  case tStructureExchange::SHARED_PORTS:
+    return "SHARED_PORTS";
+  case tStructureExchange::COMPLETE_STRUCTURE:
+    return "COMPLETE_STRUCTURE";
+  case tStructureExchange::FINSTRUCT:
+    return "FINSTRUCT";
+  default:
+    return "NONE";
+  }
+}
+
+void RunBenchmarks(const tTree& tree, const tOptions& options, const std::string& encoding_name, tStructureEncodingFlags encoding)
+{
+  rrlib::serialization::tMemoryBuffer buffer;
+  std::string string_buffer;
+
+  // Serialize
+  for (tStructureExchange level : { tStructureExchange::SHARED_PORTS, tStructureExchange::COMPLETE_STRUCTURE, tStructureExchange::FINSTRUCT })
+  {
+    const std::vector<core::tFrameworkElement*>& elements = level == tStructureExchange::SHARED_PORTS ? tree.ports : tree.elements;
+    tMeasurement measurement = Measure(elements.size(), options.iterations, [&]()
+    {
+      tStructureEncodingState encoding_state(encoding);
+      rrlib::serialization::tOutputStream stream(buffer);
+      for (core::tFrameworkElement * element : elements)
+      {
+        tFrameworkElementInfo::Serialize(stream, *element, level, string_buffer, encoding_state);
+      }
+      stream.Close();
+      return buffer.GetSize();
+    });
+    PrintMeasurement(std::string("Serialize ") + GetLevelName(level) + " (" + encoding_name + ")", measurement);
+  }
+
+  // Deserialize (SHARED_PORTS - as currently serialized in buffer)
+  {
+    tStructureEncodingState encoding_state(encoding);
+    rrlib::serialization::tOutputStream stream(buffer);
+    for (core::tFrameworkElement * element : tree.ports)
+    {
+      tFrameworkElementInfo::Serialize(stream, *element, tStructureExchange::SHARED_PORTS, string_buffer, encoding_state);
+    }
+    stream.Close();
+  }
+  tFrameworkElementInfo info;
+  tMeasurement measurement = Measure(tree.ports.size(), options.iterations, [&]()
+  {
+    tStructureEncodingState encoding_state(encoding);
+    rrlib::serialization::tInputStream stream(buffer);
+    for (size_t i = 0; i < tree.ports.size(); i++)
+    {
+      info.Deserialize(stream, encoding_state);
+    }
+    return buffer.GetSize();
+  });
+  PrintMeasurement("Deserialize SHARED_PORTS (" + encoding_name + ")", measurement);
+
+  // Deserialize to string pool (SHARED_PORTS)
+  structure_info::tStringPool string_pool;
+  structure_info::tPooledFrameworkElementInfo pooled_info;
+  measurement = Measure(tree.ports.size(), options.iterations, [&]()
+  {
+    tStructureEncodingState encoding_state(encoding);
+    rrlib::serialization::tInputStream stream(buffer);
+    string_pool.Clear();
+    for (size_t i = 0; i < tree.ports.size(); i++)
+    {
+      pooled_info.Deserialize(stream, string_pool, encoding_state);
+    }
+    return buffer.GetSize();
+  });
+  PrintMeasurement("Deserialize SHARED_PORTS to string pool (" + encoding_name + ")", measurement);
+
+  // Deserialize to columnar table (SHARED_PORTS)
+  structure_info::tRemoteStructureTable table;
+  measurement = Measure(tree.ports.size(), options.iterations, [&]()
+  {
+    tStructureEncodingState encoding_state(encoding);
+    rrlib::serialization::tInputStream stream(buffer);
+    table.Clear();
+    for (core::tFrameworkElement * element : tree.ports)
+    {
+      table.DeserializeElement(element->GetHandle(), stream, encoding_state);
+    }
+    return buffer.GetSize();
+  });
+  PrintMeasurement("Deserialize SHARED_PORTS to table (" + encoding_name + ")", measurement);
+
+  // SerializeConnections
+  measurement = Measure(tree.output_ports.size(), options.iterations, [&]()
+  {
+    tStructureEncodingState encoding_state(encoding);
+    rrlib::serialization::tOutputStream stream(buffer);
+    for (core::tAbstractPort * port : tree.output_ports)
+    {
+      tFrameworkElementInfo::SerializeConnections(stream, *port, encoding_state);
+    }
+    stream.Close();
+    return buffer.GetSize();
+  });
+  PrintMeasurement("SerializeConnections (" + encoding_name + ")", measurement);
+
+  // tNetworkConnections serialization
+  if (tree.network_connections.size())
+  {
+    bool binary_uuids = encoding.Get(tStructureEncodingFlag::BINARY_RUNTIME_IDS);
+    measurement = Measure(tree.network_connections.size(), options.iterations, [&]()
+    {
+      rrlib::serialization::tOutputStream stream(buffer);
+      for (tNetworkConnections * connections : tree.network_connections)
+      {
+        connections->Serialize(stream, binary_uuids);
+      }
+      stream.Close();
+      return buffer.GetSize();
+    });
+    PrintMeasurement("Serialize tNetworkConnections (" + encoding_name + ")", measurement);
+
+    tNetworkConnections connections;
+    measurement = Measure(tree.network_connections.size(), options.iterations, [&]()
+    {
+      rrlib::serialization::tInputStream stream(buffer);
+      for (size_t i = 0; i < tree.network_connections.size(); i++)
+      {
+        stream >> connections;
+      }
+      return buffer.GetSize();
+    });
+    PrintMeasurement("Deserialize tNetworkConnections (" + encoding_name + ")", measurement);
+  }
+}
+
+}
+
+void* operator new(size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* result = std::malloc(size ? size : 1);
+  if (!result)
+  {
+    throw std::bad_alloc();
+  }
+  return result;
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+int main(int argc, char** argv)
+{
+  tOptions options;
+  if (!ParseOptions(argc, argv, options))
+  {
+    std::printf("Usage: %s [--elements N] [--depth N] [--links N] [--fan-out N] [--network-connections N] [--iterations N]\n", argv[0]);
+    return 1;
+  }
+
+  tTree tree;
+  core::tFrameworkElement* root = new core::tFrameworkElement(&core::tRuntimeEnvironment::GetInstance(), "Structure Serialization Benchmark");
+  CreateTree(*root, options, tree);
+  std::printf("Synthetic structure: %zu elements (%zu ports), depth %zu, %zu additional links per port, fan-out %zu, %zu network connections per port\n\n",
+              tree.elements.size(), tree.ports.size(), options.depth, options.links, options.fan_out, options.network_connections);
+
+  RunBenchmarks(tree, options, "original format", tStructureEncodingFlags());
+  std::printf("\n");
+  RunBenchmarks(tree, options, "all optional encodings", tProtocolCapabilities::GetLocal().structure_encodings);
+
+  root->ManagedDelete();
+  return 0;
+}
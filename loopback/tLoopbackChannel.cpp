@@ -0,0 +1,163 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/loopback/tLoopbackChannel.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/loopback/tLoopbackChannel.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace loopback
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tLoopbackChannel::tLoopbackChannel(const tParameters& parameters) :
+  mutex(),
+  parameters(parameters),
+  queue(),
+  queued_bytes(0),
+  link_free_time()
+{}
+
+size_t tLoopbackChannel::Deliver(const tMessageHandler& handler, tTimePoint now)
+{
+  size_t count = 0;
+  while (true)
+  {
+    rrlib::serialization::tMemoryBuffer buffer(0);
+    {
+      rrlib::thread::tLock lock(mutex);
+      if (queue.empty() || queue.front().delivery_time > now)
+      {
+        return count;
+      }
+      buffer = std::move(queue.front().buffer);
+      queue.pop_front();
+      queued_bytes -= buffer.GetSize();
+    }
+    handler(buffer);
+    count++;
+  }
+}
+
+tLoopbackChannel::tTimePoint tLoopbackChannel::GetLinkFreeTime() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return link_free_time;
+}
+
+tLoopbackChannel::tTimePoint tLoopbackChannel::GetNextDeliveryTime() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return queue.empty() ? tTimePoint::max() : queue.front().delivery_time;
+}
+
+tLoopbackChannel::tParameters tLoopbackChannel::GetParameters() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return parameters;
+}
+
+size_t tLoopbackChannel::GetQueuedBytes() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return queued_bytes;
+}
+
+size_t tLoopbackChannel::GetQueuedMessages() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return queue.size();
+}
+
+bool tLoopbackChannel::Send(rrlib::serialization::tMemoryBuffer && message, tTimePoint now)
+{
+  size_t size = message.GetSize();
+  rrlib::thread::tLock lock(mutex);
+  if (parameters.max_queued_bytes && queued_bytes + size > parameters.max_queued_bytes)
+  {
+    return false;
+  }
+  std::chrono::nanoseconds transmission_time(parameters.bandwidth ? static_cast<int64_t>((size * 1000000000.0) / parameters.bandwidth) : 0);
+  link_free_time = std::max(now, link_free_time) + transmission_time;
+  tTimePoint delivery_time = link_free_time + parameters.latency;
+  if (queue.size() && delivery_time < queue.back().delivery_time)
+  {
+    delivery_time = queue.back().delivery_time; // keep order if latency was reduced
+  }
+  queue.push_back(tMessage { delivery_time, std::move(message) });
+  queued_bytes += size;
+  return true;
+}
+
+void tLoopbackChannel::SetParameters(const tParameters& parameters)
+{
+  rrlib::thread::tLock lock(mutex);
+  this->parameters = parameters;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,210 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/loopback/tLoopbackChannel.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tLoopbackChannel
+ *
+ * \b tLoopbackChannel
+ *
+ * In-memory message queue that models a unidirectional network link with
+ * configurable latency and bandwidth.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__loopback__tLoopbackChannel_h__
+#define __plugins__network_transport__loopback__tLoopbackChannel_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <chrono>
+#include <deque>
+#include <functional>
+#include "rrlib/serialization/serialization.h"
+#include "rrlib/thread/tMutex.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace loopback
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Simulated network link
+/*!
+ * Unidirectional in-memory message queue that models a network link.
+ * A message is delivered once it has been "transmitted" (size / bandwidth,
+ * after all previously sent messages) and the latency has passed.
+ * Messages are delivered in the order they were sent.
+ *
+ * All methods take the current time as optional parameter. By passing
+ * simulated time points, delivery is independent of the machine's speed -
+ * which makes benchmarks and tests repeatable.
+ *
+ * Thread-safe.
+ */
+class tLoopbackChannel
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::chrono::steady_clock tClock;
+  typedef tClock::time_point tTimePoint;
+
+  /*! Handler for delivered messages */
+  typedef std::function<void (rrlib::serialization::tMemoryBuffer& message)> tMessageHandler;
+
+  /*!
+   * Parameters of simulated link
+   */
+  struct tParameters
+  {
+    /*! Latency of link */
+    std::chrono::nanoseconds latency;
+
+    /*! Bandwidth of link in bytes per second (0 means unlimited) */
+    uint64_t bandwidth;
+
+    /*! Maximum number of bytes in queue - further messages are dropped (0 means unlimited) */
+    size_t max_queued_bytes;
+
+    tParameters() :
+      latency(0),
+      bandwidth(0),
+      max_queued_bytes(0)
+    {}
+
+    tParameters(std::chrono::nanoseconds latency, uint64_t bandwidth, size_t max_queued_bytes = 0) :
+      latency(latency),
+      bandwidth(bandwidth),
+      max_queued_bytes(max_queued_bytes)
+    {}
+  };
+
+  explicit tLoopbackChannel(const tParameters& parameters = tParameters());
+
+  /*!
+   * Delivers all messages that have arrived at the specified time.
+   * The handler is called without holding the channel's mutex (so it may send messages).
+   *
+   * \param handler Handler to call for every delivered message
+   * \param now Current time
+   * \return Number of delivered messages
+   */
+  size_t Deliver(const tMessageHandler& handler, tTimePoint now = tClock::now());
+
+  /*!
+   * \return Time at which the link has finished transmitting all messages in queue (may be in the past - link is idle then)
+   */
+  tTimePoint GetLinkFreeTime() const;
+
+  /*!
+   * \return Time at which next message arrives (tTimePoint::max() if queue is empty)
+   */
+  tTimePoint GetNextDeliveryTime() const;
+
+  /*!
+   * \return Parameters of simulated link
+   */
+  tParameters GetParameters() const;
+
+  /*!
+   * \return Number of bytes in queue
+   */
+  size_t GetQueuedBytes() const;
+
+  /*!
+   * \return Number of messages in queue
+   */
+  size_t GetQueuedMessages() const;
+
+  /*!
+   * Sends message via simulated link
+   *
+   * \param message Message to send
+   * \param now Current time
+   * \return True if message was enqueued. False if queue is full (message is dropped then).
+   */
+  bool Send(rrlib::serialization::tMemoryBuffer && message, tTimePoint now = tClock::now());
+
+  /*!
+   * \param parameters New parameters of simulated link (apply to messages sent from now on)
+   */
+  void SetParameters(const tParameters& parameters);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Message in queue */
+  struct tMessage
+  {
+    tTimePoint delivery_time;
+    rrlib::serialization::tMemoryBuffer buffer;
+  };
+
+  /*! Mutex for all variables below */
+  mutable rrlib::thread::tMutex mutex;
+
+  /*! Parameters of simulated link */
+  tParameters parameters;
+
+  /*! Messages in transit */
+  std::deque<tMessage> queue;
+
+  /*! Number of bytes in queue */
+  size_t queued_bytes;
+
+  /*! Time at which the link has finished transmitting all messages in queue */
+  tTimePoint link_free_time;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,841 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/loopback/tLoopbackTransport.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/loopback/tLoopbackTransport.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include "rrlib/thread/tLock.h"
+#include "plugins/data_ports/common/tAbstractDataPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkConnections.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace loopback
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time delivery thread sleeps before checking whether it should stop */
+const std::chrono::milliseconds cMAX_DELIVERY_WAIT(100);
+
+/*! Interval in which update rate controllers are updated */
+const std::chrono::milliseconds cRATE_CONTROL_INTERVAL(100);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+/*!
+ * \param controller Update rate controller of peer
+ * \param port Source port (may be nullptr)
+ * \return Update interval of port towards peer that is enforced by the loopback transport (zero if it is not adapted by controller)
+ */
+std::chrono::milliseconds GetAdaptedInterval(const tUpdateRateController& controller, core::tAbstractPort* port)
+{
+  if ((!port) || (!data_ports::IsDataFlowType(port->GetDataType())))
+  {
+    return std::chrono::milliseconds::zero();
+  }
+  int16_t configured = static_cast<data_ports::common::tAbstractDataPort*>(port)->GetMinNetUpdateIntervalRaw();
+  int16_t effective = controller.GetEffectiveMinNetUpdateTime(configured, tQualityOfService::Get(*port));
+  return effective != configured ? std::chrono::milliseconds(effective) : std::chrono::milliseconds::zero();
+}
+
+}
+
+/*! Plugin instance (loopback transport is a separate library - so it is only available if this library is loaded) */
+static tLoopbackTransport plugin;
+
+tLoopbackTransport::tLoopbackTransport() :
+  tNetworkTransportPlugin("loopback"),
+  mutex(),
+  peers(),
+  current_time(),
+  next_rate_control_update(),
+  delivery_mutex(),
+  delivery_condition(),
+  delivery_thread(),
+  stop_delivery_thread(false),
+  automatic_delivery(true),
+  runtime_listener_registration(),
+  runtime_listener_registered(false),
+  port_value_routes(std::bind(&tLoopbackTransport::SendPortValue, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3))
+{}
+
+void tLoopbackTransport::AddPeer(const std::string& uuid, const tLoopbackChannel::tParameters& parameters)
+{
+  std::call_once(runtime_listener_registration, [this]()
+  {
+    core::tRuntimeEnvironment::GetInstance().AddListener(*this);
+    runtime_listener_registered = true;
+    RegisterShutdownHook();
+  });
+
+  bool start_delivery_thread = false;
+  {
+    rrlib::thread::tLock lock(mutex);
+    std::unique_ptr<tPeer>& peer = peers[tRuntimeId(uuid)];
+    if (peer)
+    {
+      peer->channel.SetParameters(parameters);
+      peer->rate_controller.Reset();
+    }
+    else
+    {
+      peer.reset(new tPeer(uuid, parameters));
+    }
+    start_delivery_thread = automatic_delivery;
+  }
+  if (start_delivery_thread)
+  {
+    StartDeliveryThread();
+  }
+}
+
+std::string tLoopbackTransport::Connect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+    int remote_port_handle, const std::string remote_port_link)
+{
+  if (!data_ports::IsDataFlowType(local_port.GetDataType()))
+  {
+    return "Only data ports can be connected via loopback transport";
+  }
+  rrlib::thread::tLock lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  return UpdateConnection(local_port, remote_runtime_uuid, remote_port_handle, true);
+}
+
+void tLoopbackTransport::DeliveryLoop()
+{
+  std::unique_lock<std::mutex> lock(delivery_mutex);
+  while (!stop_delivery_thread)
+  {
+    tLoopbackChannel::tTimePoint next_delivery = tLoopbackChannel::tTimePoint::max();
+    {
+      rrlib::thread::tLock peers_lock(mutex);
+      for (auto & peer : peers)
+      {
+        next_delivery = std::min(next_delivery, peer.second->channel.GetNextDeliveryTime());
+        if (!peer.second->scheduler.Empty())
+        {
+          next_delivery = std::min(next_delivery, peer.second->channel.GetLinkFreeTime());
+        }
+        for (auto & pending : peer.second->pending_values)
+        {
+          if (!pending.second.scheduled)
+          {
+            next_delivery = std::min(next_delivery, pending.second.earliest_send_time);
+          }
+        }
+      }
+      for (auto & peer : peers)
+      {
+        if (peer.second->structure_batcher)
+        {
+          next_delivery = std::min(next_delivery, peer.second->structure_reset_pending ? tLoopbackChannel::tTimePoint() : peer.second->structure_batcher->GetFlushTime());
+        }
+      }
+      if (!peers.empty())
+      {
+        next_delivery = std::min(next_delivery, next_rate_control_update);
+      }
+    }
+    tLoopbackChannel::tTimePoint now = tLoopbackChannel::tClock::now();
+    if (next_delivery <= now)
+    {
+      lock.unlock();
+      ProcessMessages(now);
+      lock.lock();
+    }
+    else
+    {
+      delivery_condition.wait_until(lock, std::min(next_delivery, now + cMAX_DELIVERY_WAIT));
+    }
+  }
+}
+
+void tLoopbackTransport::DeferPortValue(tPeer& peer, core::tFrameworkElement::tHandle handle, const std::vector<core::tFrameworkElement::tHandle>& remote_handles,
+                                        const rrlib::rtti::tGenericObject& value, tLoopbackChannel::tTimePoint now)
+{
+  tPendingValue& pending = peer.pending_values[handle];
+  rrlib::serialization::tOutputStream stream(pending.value);
+  value.Serialize(stream);
+  stream.Close();
+  pending.remote_handles = remote_handles;
+  auto next_send_time = peer.next_send_times.find(handle);
+  pending.earliest_send_time = next_send_time != peer.next_send_times.end() ? next_send_time->second : now;
+
+  if ((!pending.scheduled) && pending.earliest_send_time <= now)
+  {
+    core::tAbstractPort* port = core::tRuntimeEnvironment::GetInstance().GetPort(handle);
+    peer.scheduler.Enqueue(handle, port ? tQualityOfService::Get(*port) : tQualityOfService(), now);
+    pending.scheduled = true;
+  }
+}
+
+std::string tLoopbackTransport::Disconnect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+    int remote_port_handle, const std::string remote_port_link)
+{
+  rrlib::thread::tLock lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  return UpdateConnection(local_port, remote_runtime_uuid, remote_port_handle, false);
+}
+
+tTransportCost tLoopbackTransport::EstimateCost(const tRuntimeId& remote_runtime) const
+{
+  rrlib::thread::tLock lock(mutex);
+  auto it = peers.find(remote_runtime);
+  if (it == peers.end())
+  {
+    return tTransportCost(tTransportCost::tReachability::UNREACHABLE, std::chrono::nanoseconds(-1), 0);
+  }
+  tLoopbackChannel::tParameters parameters = it->second->channel.GetParameters();
+  return tTransportCost(tTransportCost::tReachability::REACHABLE, parameters.latency, parameters.bandwidth ? parameters.bandwidth : std::numeric_limits<uint64_t>::max());
+}
+
+tLoopbackChannel* tLoopbackTransport::GetChannel(const std::string& uuid)
+{
+  rrlib::thread::tLock lock(mutex);
+  auto it = peers.find(tRuntimeId(uuid));
+  return it != peers.end() ? &it->second->channel : nullptr;
+}
+
+int16_t tLoopbackTransport::GetEffectiveMinNetUpdateTime(const std::string& uuid, core::tAbstractPort& port) const
+{
+  int16_t configured = data_ports::IsDataFlowType(port.GetDataType()) ? static_cast<data_ports::common::tAbstractDataPort&>(port).GetMinNetUpdateIntervalRaw() : 0;
+  rrlib::thread::tLock lock(mutex);
+  auto it = peers.find(tRuntimeId(uuid));
+  return it != peers.end() ? it->second->rate_controller.GetEffectiveMinNetUpdateTime(configured, tQualityOfService::Get(port)) : configured;
+}
+
+structure_info::tRemoteStructureTable tLoopbackTransport::GetPeerStructure(const std::string& uuid) const
+{
+  rrlib::thread::tLock lock(mutex);
+  auto it = peers.find(tRuntimeId(uuid));
+  return it != peers.end() ? it->second->structure : structure_info::tRemoteStructureTable();
+}
+
+tUpdateRateController* tLoopbackTransport::GetUpdateRateController(const std::string& uuid)
+{
+  rrlib::thread::tLock lock(mutex);
+  auto it = peers.find(tRuntimeId(uuid));
+  return it != peers.end() ? &it->second->rate_controller : nullptr;
+}
+
+void tLoopbackTransport::OnEdgeChange(core::tRuntimeListener::tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target)
+{
+}
+
+void tLoopbackTransport::OnFrameworkElementChange(core::tRuntimeListener::tEvent change_type, core::tFrameworkElement& element)
+{
+  if (change_type == core::tRuntimeListener::tEvent::REMOVE && element.IsPort())
+  {
+    core::tFrameworkElement::tHandle handle = element.GetHandle();
+    port_value_routes.RemovePort(static_cast<core::tAbstractPort&>(element));
+    port_value_routes.RemoveRoutes([handle](const tPortValueRoutes::tRoute & route)
+    {
+      return route.remote_handle == handle;
+    });
+
+    rrlib::thread::tLock lock(mutex);
+    for (auto & peer : peers)
+    {
+      peer.second->scheduler.Remove(handle);
+      peer.second->pending_values.erase(handle);
+      peer.second->next_send_times.erase(handle);
+      for (auto & pending : peer.second->pending_values)
+      {
+        std::vector<core::tFrameworkElement::tHandle>& remote_handles = pending.second.remote_handles;
+        remote_handles.erase(std::remove(remote_handles.begin(), remote_handles.end(), handle), remote_handles.end());
+      }
+    }
+  }
+}
+
+void tLoopbackTransport::OnPortValueSent(tPeer& peer, core::tFrameworkElement::tHandle handle, tLoopbackChannel::tTimePoint now)
+{
+  std::chrono::milliseconds interval = GetAdaptedInterval(peer.rate_controller, core::tRuntimeEnvironment::GetInstance().GetPort(handle));
+  if (interval > std::chrono::milliseconds::zero())
+  {
+    peer.next_send_times[handle] = now + interval;
+  }
+  else
+  {
+    peer.next_send_times.erase(handle);
+  }
+}
+
+size_t tLoopbackTransport::ProcessMessages(tLoopbackChannel::tTimePoint now)
+{
+  SendStructureChanges(now);
+
+  // Collect messages first: publishing values may trigger sending further messages
+  std::vector<rrlib::serialization::tMemoryBuffer> messages;
+  std::vector<std::pair<tRuntimeId, structure_info::tStructureFilter>> subscriptions;
+  size_t delivered = 0;
+  {
+    rrlib::thread::tLock lock(mutex);
+    current_time = now;
+    if (now >= next_rate_control_update)
+    {
+      UpdateRateControllers(now);
+      next_rate_control_update = now + cRATE_CONTROL_INTERVAL;
+    }
+    SendPendingValues(now);
+    for (auto & peer : peers)
+    {
+      tPeer& receiver = *peer.second;
+      const tRuntimeId& receiver_id = peer.first;
+      delivered += receiver.channel.Deliver([&messages, &subscriptions, &receiver, &receiver_id](rrlib::serialization::tMemoryBuffer & message)
+      {
+        {
+          rrlib::serialization::tInputStream stream(message);
+          tOpCode opcode = static_cast<tOpCode>(stream.ReadByte());
+          if (opcode == tOpCode::STRUCTURE_CHANGES)
+          {
+            // Structure info is applied to peer's view directly
+            if (stream.ReadBoolean())
+            {
+              receiver.structure.Clear();
+            }
+            structure_info::tStructureEncodingState encoding_state;
+            receiver.structure.DeserializeChangeBatch(stream, encoding_state);
+            return;
+          }
+          if (opcode == tOpCode::SUBSCRIBE_STRUCTURE)
+          {
+            structure_info::tStructureFilter filter;
+            try
+            {
+              stream >> filter;
+            }
+            catch (const std::exception& e)
+            {
+              FINROC_LOG_PRINT(WARNING, "Rejected invalid structure subscription of ", receiver.uuid, ": ", e.what());
+              return;
+            }
+            subscriptions.emplace_back(receiver_id, filter);
+            return;
+          }
+        }
+        messages.push_back(std::move(message));
+      }, now);
+    }
+  }
+  for (rrlib::serialization::tMemoryBuffer & message : messages)
+  {
+    rrlib::serialization::tInputStream stream(message);
+    stream.ReadByte();  // tOpCode::PORT_VALUE
+    core::tFrameworkElement::tHandle handle = stream.ReadInt();
+    tPortValueRoutes::PublishValue(handle, stream);
+  }
+
+  if (!subscriptions.empty())
+  {
+    for (auto & subscription : subscriptions)
+    {
+      ProcessStructureSubscription(subscription.first, subscription.second);
+    }
+    SendStructureChanges(now);
+  }
+  return delivered;
+}
+
+void tLoopbackTransport::RemovePeer(const std::string& uuid)
+{
+  tRuntimeId peer(uuid);
+  rrlib::thread::tLock structure_lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  tNetworkConnections::RemoveAllConnectionsTo(peer);
+  port_value_routes.RemoveRoutes([&peer](const tPortValueRoutes::tRoute & route)
+  {
+    return route.peer == peer;
+  });
+  std::unique_ptr<tPeer> removed_peer;
+  {
+    rrlib::thread::tLock lock(mutex);
+    auto it = peers.find(peer);
+    if (it != peers.end())
+    {
+      removed_peer = std::move(it->second);
+      peers.erase(it);
+    }
+  }
+  // (peer's structure batcher is deleted here - without holding mutex)
+}
+
+void tLoopbackTransport::ProcessStructureSubscription(const tRuntimeId& peer_id, const structure_info::tStructureFilter& filter)
+{
+  std::shared_ptr<structure_info::tStructureChangeBatcher> batcher;
+  structure_info::tStructureChangeBatcher::tParameters parameters;
+  {
+    rrlib::thread::tLock lock(mutex);
+    auto peer = peers.find(peer_id);
+    if (peer == peers.end())
+    {
+      return;
+    }
+    batcher = peer->second->structure_batcher;
+    parameters = peer->second->structure_batcher_parameters;
+  }
+
+  if (batcher)
+  {
+    // Peer only needs the differences
+    batcher->SetFilter(filter);
+    return;
+  }
+
+  batcher.reset(new structure_info::tStructureChangeBatcher(structure_info::tStructureExchange::SHARED_PORTS, parameters, filter));
+  {
+    rrlib::thread::tLock lock(mutex);
+    auto peer = peers.find(peer_id);
+    if (peer != peers.end() && (!peer->second->structure_batcher))
+    {
+      peer->second->structure_batcher = batcher;
+      peer->second->structure_reset_pending = true;
+      return;
+    }
+  }
+  // Peer was removed or subscribed in the meantime: batcher is deleted here - without holding mutex
+  batcher.reset();
+  ProcessStructureSubscription(peer_id, filter);
+}
+
+bool tLoopbackTransport::SendPendingValues(tLoopbackChannel::tTimePoint now)
+{
+  bool sent = false;
+  for (auto & entry : peers)
+  {
+    tPeer& peer = *entry.second;
+    for (auto & pending : peer.pending_values)
+    {
+      if ((!pending.second.scheduled) && pending.second.earliest_send_time <= now)
+      {
+        core::tAbstractPort* port = core::tRuntimeEnvironment::GetInstance().GetPort(pending.first);
+        peer.scheduler.Enqueue(pending.first, port ? tQualityOfService::Get(*port) : tQualityOfService(), now);
+        pending.second.scheduled = true;
+      }
+    }
+
+    core::tFrameworkElement::tHandle handle;
+    while (peer.channel.GetLinkFreeTime() <= now && peer.scheduler.Dequeue(handle))
+    {
+      auto pending = peer.pending_values.find(handle);
+      if (pending == peer.pending_values.end())
+      {
+        continue;
+      }
+      for (core::tFrameworkElement::tHandle remote_handle : pending->second.remote_handles)
+      {
+        rrlib::serialization::tMemoryBuffer buffer;
+        rrlib::serialization::tOutputStream stream(buffer);
+        stream.WriteByte(static_cast<uint8_t>(tOpCode::PORT_VALUE));
+        stream.WriteInt(remote_handle);
+        stream.Write(pending->second.value.GetBuffer(), 0, pending->second.value.GetSize());
+        stream.Close();
+        if (peer.channel.Send(std::move(buffer), now))
+        {
+          sent = true;
+        }
+        else
+        {
+          FINROC_LOG_PRINT(DEBUG_WARNING, "Queue of link to ", peer.uuid, " is full. Dropping value of port ", handle, ".");
+        }
+      }
+      peer.pending_values.erase(pending);
+      OnPortValueSent(peer, handle, now);
+    }
+  }
+  return sent;
+}
+
+void tLoopbackTransport::SendPortValue(core::tFrameworkElement::tHandle handle, const std::vector<tPortValueRoutes::tRoute>& routes, const rrlib::rtti::tGenericObject& value)
+{
+  bool sent = false;
+  {
+    rrlib::thread::tLock lock(mutex);
+    tLoopbackChannel::tTimePoint now = automatic_delivery ? tLoopbackChannel::tClock::now() : current_time;
+    std::unordered_map<tPeer*, std::vector<core::tFrameworkElement::tHandle>> deferred_routes;
+    std::unordered_set<tPeer*> sent_to_peers;
+    for (const tPortValueRoutes::tRoute & route : routes)
+    {
+      auto peer = peers.find(route.peer);
+      if (peer == peers.end())
+      {
+        continue;
+      }
+      tPeer* peer_ptr = peer->second.get();
+      auto next_send_time = peer_ptr->next_send_times.find(handle);
+      bool interval_passed = next_send_time == peer_ptr->next_send_times.end() || next_send_time->second <= now;
+      bool defer = deferred_routes.count(peer_ptr) ||
+                   ((!sent_to_peers.count(peer_ptr)) && (peer_ptr->channel.GetLinkFreeTime() > now || (!peer_ptr->scheduler.Empty()) || (!interval_passed)));
+      if (defer)
+      {
+        // Link is busy or update interval has not passed: value is sent later (unless there is a newer value then)
+        deferred_routes[peer_ptr].push_back(route.remote_handle);
+        continue;
+      }
+      rrlib::serialization::tMemoryBuffer buffer;
+      rrlib::serialization::tOutputStream stream(buffer);
+      stream.WriteByte(static_cast<uint8_t>(tOpCode::PORT_VALUE));
+      stream.WriteInt(route.remote_handle);
+      value.Serialize(stream);
+      stream.Close();
+      sent_to_peers.insert(peer_ptr);
+      if (peer_ptr->channel.Send(std::move(buffer), now))
+      {
+        sent = true;
+      }
+      else
+      {
+        FINROC_LOG_PRINT(DEBUG_WARNING, "Queue of link to ", peer_ptr->uuid, " is full. Dropping value of port ", handle, ".");
+      }
+    }
+    for (tPeer* peer : sent_to_peers)
+    {
+      OnPortValueSent(*peer, handle, now);
+    }
+    for (auto & entry : deferred_routes)
+    {
+      DeferPortValue(*entry.first, handle, entry.second, value, now);
+    }
+  }
+  if (sent)
+  {
+    std::lock_guard<std::mutex> lock(delivery_mutex);
+    delivery_condition.notify_one();
+  }
+}
+
+bool tLoopbackTransport::SendStructureChanges(tLoopbackChannel::tTimePoint now)
+{
+  struct tSubscription
+  {
+    tRuntimeId peer;
+    std::shared_ptr<structure_info::tStructureChangeBatcher> batcher;
+    bool reset;
+  };
+  std::vector<tSubscription> subscriptions;
+  {
+    rrlib::thread::tLock lock(mutex);
+    for (auto & peer : peers)
+    {
+      const std::shared_ptr<structure_info::tStructureChangeBatcher>& batcher = peer.second->structure_batcher;
+      if (batcher && (peer.second->structure_reset_pending || batcher->IsBatchReady(now)))
+      {
+        subscriptions.push_back({ peer.first, batcher, peer.second->structure_reset_pending });
+      }
+    }
+  }
+
+  bool sent = false;
+  std::string string_buffer;
+  for (tSubscription & subscription : subscriptions)
+  {
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream stream(buffer);
+    stream.WriteByte(static_cast<uint8_t>(tOpCode::STRUCTURE_CHANGES));
+    stream.WriteBoolean(subscription.reset);
+    structure_info::tStructureEncodingState encoding_state;
+    if (subscription.reset)
+    {
+      // Send all matching elements as ADD
+      core::tRuntimeEnvironment& runtime = core::tRuntimeEnvironment::GetInstance();
+      rrlib::thread::tLock structure_lock(runtime.GetStructureMutex());
+      structure_info::tStructureFilter filter = subscription.batcher->GetFilter();
+      std::vector<core::tFrameworkElement*> elements;
+      for (auto it = runtime.SubElementsBegin(true); it != runtime.SubElementsEnd(); ++it)
+      {
+        core::tFrameworkElement& element = *it;
+        if (element.IsReady() && element.IsPort() && element.GetFlag(core::tFrameworkElement::tFlag::SHARED) && filter.Matches(element))
+        {
+          elements.push_back(&element);
+        }
+      }
+      structure_info::tStructureChangeBatch::WriteChangeCount(stream, elements.size());
+      for (core::tFrameworkElement * element : elements)
+      {
+        structure_info::tStructureChangeBatch::WriteChange(stream, structure_info::tStructureChangeType::ADD, element->GetHandle());
+        structure_info::tFrameworkElementInfo::Serialize(stream, *element, structure_info::tStructureExchange::SHARED_PORTS, string_buffer, encoding_state);
+      }
+      subscription.batcher->SetClientElements(elements);
+    }
+    else
+    {
+      subscription.batcher->SerializeBatch(stream, string_buffer, encoding_state);
+    }
+    stream.Close();
+
+    rrlib::thread::tLock lock(mutex);
+    auto peer = peers.find(subscription.peer);
+    if (peer == peers.end() || peer->second->structure_batcher != subscription.batcher)
+    {
+      continue;  // peer was removed or subscribed again in the meantime
+    }
+    if (subscription.reset)
+    {
+      peer->second->structure_reset_pending = false;
+    }
+    if (peer->second->channel.Send(std::move(buffer), now))
+    {
+      sent = true;
+    }
+    else
+    {
+      // Peer's structure info is incomplete now - so send it all matching elements again
+      FINROC_LOG_PRINT(DEBUG_WARNING, "Queue of link to ", peer->second->uuid, " is full. Dropped structure changes - sending all matching elements instead.");
+      peer->second->structure_reset_pending = true;
+    }
+  }
+  return sent;
+}
+
+void tLoopbackTransport::SetAutomaticDelivery(bool automatic_delivery)
+{
+  {
+    rrlib::thread::tLock lock(mutex);
+    this->automatic_delivery = automatic_delivery;
+  }
+  if (automatic_delivery)
+  {
+    StartDeliveryThread();
+  }
+  else
+  {
+    StopDeliveryThread();
+  }
+}
+
+void tLoopbackTransport::Shutdown()
+{
+  StopDeliveryThread();
+  if (runtime_listener_registered)
+  {
+    core::tRuntimeEnvironment::GetInstance().RemoveListener(*this);
+    runtime_listener_registered = false;
+  }
+
+  // Batchers unregister from runtime environment on destruction (must happen before static destruction)
+  std::vector<std::shared_ptr<structure_info::tStructureChangeBatcher>> batchers;
+  {
+    rrlib::thread::tLock lock(mutex);
+    for (auto & peer : peers)
+    {
+      batchers.push_back(std::move(peer.second->structure_batcher));
+    }
+  }
+}
+
+void tLoopbackTransport::StartDeliveryThread()
+{
+  RegisterShutdownHook();
+  std::lock_guard<std::mutex> lock(delivery_mutex);
+  if (!delivery_thread.joinable())
+  {
+    stop_delivery_thread = false;
+    delivery_thread = std::thread(&tLoopbackTransport::DeliveryLoop, this);
+  }
+}
+
+void tLoopbackTransport::StopDeliveryThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(delivery_mutex);
+    if (!delivery_thread.joinable())
+    {
+      return;
+    }
+    stop_delivery_thread = true;
+  }
+  delivery_condition.notify_one();
+  delivery_thread.join();
+}
+
+std::string tLoopbackTransport::SubscribeStructure(const std::string& uuid, const structure_info::tStructureFilter& filter, const structure_info::tStructureChangeBatcher::tParameters& parameters)
+{
+  rrlib::serialization::tMemoryBuffer buffer;
+  rrlib::serialization::tOutputStream stream(buffer);
+  stream.WriteByte(static_cast<uint8_t>(tOpCode::SUBSCRIBE_STRUCTURE));
+  stream << filter;
+  stream.Close();
+  {
+    rrlib::thread::tLock lock(mutex);
+    auto peer = peers.find(tRuntimeId(uuid));
+    if (peer == peers.end())
+    {
+      return "Unknown loopback peer '" + uuid + "'";
+    }
+    peer->second->structure_batcher_parameters = parameters;
+    if (!peer->second->channel.Send(std::move(buffer), automatic_delivery ? tLoopbackChannel::tClock::now() : current_time))
+    {
+      return "Queue of link to '" + uuid + "' is full";
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(delivery_mutex);
+  delivery_condition.notify_one();
+  return "";
+}
+
+std::string tLoopbackTransport::UpdateConnection(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, int remote_port_handle, bool add)
+{
+  core::tAbstractPort* remote_port = core::tRuntimeEnvironment::GetInstance().GetPort(remote_port_handle);
+  if (!remote_port)
+  {
+    return "Port with handle " + std::to_string(remote_port_handle) + " does not exist (ports of loopback peers are ports in this runtime environment)";
+  }
+  if (add)
+  {
+    if (!data_ports::IsDataFlowType(remote_port->GetDataType()))
+    {
+      return "Port with handle " + std::to_string(remote_port_handle) + " is no data port";
+    }
+    if (remote_port->GetDataType() != local_port.GetDataType())
+    {
+      return std::string("Data types of ports differ (local: ") + local_port.GetDataType().GetName() + ", remote: " + remote_port->GetDataType().GetName() + ")";
+    }
+    if (remote_port->IsOutputPort() == local_port.IsOutputPort())
+    {
+      return local_port.IsOutputPort() ? "Both ports are output ports" : "Both ports are input ports";
+    }
+  }
+  bool local_port_is_source = local_port.IsOutputPort();
+  core::tAbstractPort& source = local_port_is_source ? local_port : *remote_port;
+  core::tAbstractPort& destination = local_port_is_source ? *remote_port : local_port;
+  tPortValueRoutes::tRoute route = { tRuntimeId(remote_runtime_uuid), destination.GetHandle() };
+
+  {
+    rrlib::thread::tLock lock(mutex);
+    if (peers.find(route.peer) == peers.end())
+    {
+      return "Unknown loopback peer '" + remote_runtime_uuid + "'";
+    }
+  }
+  if (add)
+  {
+    port_value_routes.Add(source, route);
+  }
+  else
+  {
+    port_value_routes.Remove(source, route);
+  }
+
+  tNetworkConnection connection(remote_runtime_uuid, remote_port_handle, !local_port_is_source);
+  tNetworkConnections* connections = local_port.GetAnnotation<tNetworkConnections>();
+  if (add)
+  {
+    if (!connections)
+    {
+      connections = new tNetworkConnections();
+      local_port.AddAnnotation(connections);
+    }
+    connections->Add(connection);
+  }
+  else
+  {
+    if (connections)
+    {
+      connections->Remove(connection);
+    }
+
+    // Pending value must not be sent via removed route
+    rrlib::thread::tLock lock(mutex);
+    auto peer = peers.find(route.peer);
+    if (peer != peers.end())
+    {
+      auto pending = peer->second->pending_values.find(source.GetHandle());
+      if (pending != peer->second->pending_values.end())
+      {
+        std::vector<core::tFrameworkElement::tHandle>& remote_handles = pending->second.remote_handles;
+        remote_handles.erase(std::remove(remote_handles.begin(), remote_handles.end(), route.remote_handle), remote_handles.end());
+        if (remote_handles.empty())
+        {
+          peer->second->pending_values.erase(pending);
+          peer->second->scheduler.Remove(source.GetHandle());
+        }
+      }
+    }
+  }
+  return "";
+}
+
+void tLoopbackTransport::UpdateRateControllers(tLoopbackChannel::tTimePoint now)
+{
+  for (auto & entry : peers)
+  {
+    tPeer& peer = *entry.second;
+    tLoopbackChannel::tParameters parameters = peer.channel.GetParameters();
+
+    // Round-trip time of a message sent now: twice the latency plus the time until the link has transmitted everything before it.
+    // Controller interprets zero as 'no measurement' - so report at least 1 ns.
+    std::chrono::nanoseconds queuing_delay = std::max(std::chrono::nanoseconds::zero(), std::chrono::duration_cast<std::chrono::nanoseconds>(peer.channel.GetLinkFreeTime() - now));
+    std::chrono::nanoseconds round_trip_time = std::max(std::chrono::nanoseconds(1), 2 * parameters.latency + queuing_delay);
+
+    if (peer.rate_controller.Update(peer.channel.GetQueuedMessages() + peer.pending_values.size(), round_trip_time))
+    {
+      FINROC_LOG_PRINT(DEBUG, "Adaptive update interval of link to ", peer.uuid, " is now ", peer.rate_controller.GetCurrentInterval(), " ms");
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,404 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/loopback/tLoopbackTransport.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tLoopbackTransport
+ *
+ * \b tLoopbackTransport
+ *
+ * Network transport that connects ports within the same process via
+ * simulated network links (tLoopbackChannel). Values are serialized, pass
+ * through a link with configurable latency and bandwidth and are deserialized
+ * again - as with a real network transport, but without sockets.
+ * Intended for testing and benchmarking the transport hot paths.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__loopback__tLoopbackTransport_h__
+#define __plugins__network_transport__loopback__tLoopbackTransport_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include "core/tRuntimeEnvironment.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkTransportPlugin.h"
+#include "plugins/network_transport/tPortValueRoutes.h"
+#include "plugins/network_transport/tSendScheduler.h"
+#include "plugins/network_transport/tUpdateRateController.h"
+#include "plugins/network_transport/structure_info/tRemoteStructureTable.h"
+#include "plugins/network_transport/structure_info/tStructureChangeBatcher.h"
+#include "plugins/network_transport/loopback/tLoopbackChannel.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace loopback
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Loopback transport
+/*!
+ * Network transport plugin that simulates remote runtime environments inside
+ * the local process.
+ *
+ * Simulated peers are added with AddPeer() - each with its own UUID and link
+ * parameters. Port handles of a simulated peer are handles of ports in the
+ * local runtime environment. Connecting a local port to a port of a peer
+ * therefore connects two local ports via the peer's simulated link
+ * (they must be data ports with the same data type and opposite direction).
+ * Connections are stored in tNetworkConnections annotations - as with any
+ * other network transport.
+ *
+ * Values that are published while the link to a peer is still busy transmitting
+ * previous messages are not queued behind them: only the latest value of each port
+ * is kept - and sent when the link becomes free, in the order of the ports'
+ * quality of service settings (see tSendScheduler).
+ *
+ * Each peer has a tUpdateRateController that is updated periodically with the
+ * state of the simulated link (values waiting for the link, messages in transit
+ * and the delay a new message would experience). If the link is congested, values
+ * of lower-priority ports are sent to this peer less often. As port info is
+ * shared by all peers, the effective interval is applied when sending - it can be
+ * queried per peer with GetEffectiveMinNetUpdateTime().
+ *
+ * Peers can be subscribed to the structure of the local runtime environment
+ * (shared ports - see SubscribeStructure()). The subscription is sent via the peer's
+ * link. A subscribed peer is sent info on all matching ports and then batches of
+ * changes (tStructureChangeBatcher). If the filter changes, only the differences are sent.
+ * Its resulting view of the local structure is available via GetPeerStructure().
+ *
+ * By default, a delivery thread delivers messages when they arrive.
+ * For repeatable measurements, automatic delivery can be disabled - and
+ * messages are delivered by calling ProcessMessages() with simulated time points.
+ * Values are then sent at the time point passed to the last ProcessMessages() call.
+ */
+class tLoopbackTransport : public tNetworkTransportPlugin, public core::tRuntimeListener
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tLoopbackTransport();
+
+  /*!
+   * Adds simulated peer (or changes link parameters of existing peer)
+   *
+   * \param uuid UUID of simulated remote runtime environment
+   * \param parameters Parameters of simulated link to this peer
+   */
+  void AddPeer(const std::string& uuid, const tLoopbackChannel::tParameters& parameters = tLoopbackChannel::tParameters());
+
+  virtual std::string Connect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+                              int remote_port_handle, const std::string remote_port_link) override;
+
+  virtual std::string Disconnect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+                                 int remote_port_handle, const std::string remote_port_link) override;
+
+  /*!
+   * Simulated peers are reachable - with the latency and bandwidth of their links
+   */
+  virtual tTransportCost EstimateCost(const tRuntimeId& remote_runtime) const override;
+
+  /*!
+   * \param uuid UUID of simulated peer
+   * \return Simulated link to this peer (nullptr if there is no such peer). May be used to change link parameters or to inspect queue.
+   */
+  tLoopbackChannel* GetChannel(const std::string& uuid);
+
+  /*!
+   * (caller must hold runtime's structure mutex)
+   *
+   * \param uuid UUID of simulated peer
+   * \param port Local port
+   * \return Minimum network update interval that is currently applied to values of this port sent to this peer
+   *         (value that would be in the port's changeable info for this peer; -1 for default; configured value if peer does not exist)
+   */
+  int16_t GetEffectiveMinNetUpdateTime(const std::string& uuid, core::tAbstractPort& port) const;
+
+  /*!
+   * \param uuid UUID of simulated peer
+   * \return Peer's info on the structure of the local runtime environment - as received via its link (empty if peer has no structure subscription)
+   */
+  structure_info::tRemoteStructureTable GetPeerStructure(const std::string& uuid) const;
+
+  /*!
+   * \param uuid UUID of simulated peer
+   * \return Update rate controller for the link to this peer (nullptr if there is no such peer). May be used to change its parameters.
+   */
+  tUpdateRateController* GetUpdateRateController(const std::string& uuid);
+
+  /*!
+   * Delivers all messages that have arrived at the specified time
+   *
+   * \param now Current time
+   * \return Number of delivered messages
+   */
+  size_t ProcessMessages(tLoopbackChannel::tTimePoint now = tLoopbackChannel::tClock::now());
+
+  /*!
+   * Removes simulated peer and all connections to it
+   *
+   * \param uuid UUID of simulated peer
+   */
+  void RemovePeer(const std::string& uuid);
+
+  /*!
+   * \param automatic_delivery Whether messages should be delivered by a delivery thread (default) - or by calling ProcessMessages()
+   */
+  void SetAutomaticDelivery(bool automatic_delivery);
+
+  /*!
+   * Stops delivery thread and unregisters from runtime environment
+   */
+  virtual void Shutdown() override;
+
+  /*!
+   * Lets simulated peer subscribe to the structure of the local runtime environment (structure exchange level SHARED_PORTS).
+   * The subscription message passes the peer's link. When it arrives, the peer is sent info on all matching shared ports -
+   * and then batches of changes. If peer is already subscribed, its filter is changed: the peer is sent ADD for elements
+   * that start matching - and REMOVE for elements that no longer match.
+   *
+   * \param uuid UUID of simulated peer
+   * \param filter Filter of structure subscription
+   * \param parameters Configuration of batcher that collects changes for peer (only used if peer is not subscribed yet)
+   * \return Error message - or empty string on success
+   */
+  std::string SubscribeStructure(const std::string& uuid, const structure_info::tStructureFilter& filter = structure_info::tStructureFilter(),
+                                 const structure_info::tStructureChangeBatcher::tParameters& parameters = structure_info::tStructureChangeBatcher::tParameters());
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Types of messages on simulated links (first byte of each message) */
+  enum class tOpCode : uint8_t
+  {
+    PORT_VALUE,          //!< New value for port (receiver port handle, serialized value)
+    STRUCTURE_CHANGES,   //!< Changes to structure (bool: whether peer discards its info first - as it is sent all matching elements, tStructureChangeBatch)
+    SUBSCRIBE_STRUCTURE  //!< Structure subscription of peer - or change of its filter (tStructureFilter)
+  };
+
+  /*! Latest value of a source port that waits for the link to become free */
+  struct tPendingValue
+  {
+    /*! Serialized value */
+    rrlib::serialization::tMemoryBuffer value;
+
+    /*! Handles of the peer's ports to send value to */
+    std::vector<core::tFrameworkElement::tHandle> remote_handles;
+
+    /*! Value must not be sent before this time (adaptive update interval) */
+    tLoopbackChannel::tTimePoint earliest_send_time;
+
+    /*! Whether value has been enqueued in peer's scheduler (happens at earliest_send_time) */
+    bool scheduled;
+
+    tPendingValue() :
+      value(),
+      remote_handles(),
+      earliest_send_time(),
+      scheduled(false)
+    {}
+  };
+
+  /*! Simulated peer */
+  struct tPeer
+  {
+    std::string uuid;
+    tLoopbackChannel channel;
+
+    /*! Source ports with pending values - most urgent first */
+    tSendScheduler scheduler;
+
+    /*! Pending values (key is handle of source port) */
+    std::unordered_map<core::tFrameworkElement::tHandle, tPendingValue> pending_values;
+
+    /*! Adapts update interval of lower-priority ports to state of link */
+    tUpdateRateController rate_controller;
+
+    /*! Times before which source ports must not send values to this peer (only contains ports with adapted interval) */
+    std::unordered_map<core::tFrameworkElement::tHandle, tLoopbackChannel::tTimePoint> next_send_times;
+
+    /*! Collects structure changes for peer (nullptr if peer has no structure subscription) */
+    std::shared_ptr<structure_info::tStructureChangeBatcher> structure_batcher;
+
+    /*! Configuration of batcher that is created when subscription of peer arrives */
+    structure_info::tStructureChangeBatcher::tParameters structure_batcher_parameters;
+
+    /*! Whether peer needs to be sent info on all matching elements (after subscription or lost message) */
+    bool structure_reset_pending;
+
+    /*! Peer's info on structure of local runtime environment (as received via link) */
+    structure_info::tRemoteStructureTable structure;
+
+    tPeer(const std::string& uuid, const tLoopbackChannel::tParameters& parameters) :
+      uuid(uuid),
+      channel(parameters),
+      scheduler(),
+      pending_values(),
+      rate_controller(),
+      next_send_times(),
+      structure_batcher(),
+      structure_batcher_parameters(),
+      structure_reset_pending(false),
+      structure()
+    {}
+  };
+
+  /*! Mutex for all variables below (acquire after runtime's structure mutex and mutex of port_value_routes) */
+  mutable rrlib::thread::tMutex mutex;
+
+  /*! Simulated peers */
+  std::unordered_map<tRuntimeId, std::unique_ptr<tPeer>> peers;
+
+  /*! Time passed to last ProcessMessages() call (values are sent at this time if automatic delivery is disabled) */
+  tLoopbackChannel::tTimePoint current_time;
+
+  /*! Time at which update rate controllers are updated next */
+  tLoopbackChannel::tTimePoint next_rate_control_update;
+
+  /*! Mutex and condition variable for delivery thread */
+  std::mutex delivery_mutex;
+  std::condition_variable delivery_condition;
+
+  /*! Thread delivering messages (if automatic delivery is enabled) */
+  std::thread delivery_thread;
+
+  /*! Set to stop delivery thread */
+  bool stop_delivery_thread;
+
+  /*! Whether messages are delivered by delivery thread */
+  bool automatic_delivery;
+
+  /*! Registered as runtime listener? (happens when first peer is added) */
+  std::once_flag runtime_listener_registration;
+  bool runtime_listener_registered;
+
+  /*! Destinations of values of source ports (remote handles are handles of local destination ports) */
+  tPortValueRoutes port_value_routes;
+
+
+  /*! Delivery thread main loop */
+  void DeliveryLoop();
+
+  /*!
+   * Stores value of source port as pending value for peer (caller must hold mutex)
+   *
+   * \param peer Peer whose link is busy - or whose update interval for this port has not yet passed
+   * \param handle Handle of source port
+   * \param remote_handles Handles of the peer's ports to send value to
+   * \param value Value to send
+   * \param now Current time
+   */
+  void DeferPortValue(tPeer& peer, core::tFrameworkElement::tHandle handle, const std::vector<core::tFrameworkElement::tHandle>& remote_handles,
+                      const rrlib::rtti::tGenericObject& value, tLoopbackChannel::tTimePoint now);
+
+  /*!
+   * Called after value of source port has been sent to peer (caller must hold mutex)
+   * Records when the port may send to this peer again (if its update interval is adapted).
+   */
+  void OnPortValueSent(tPeer& peer, core::tFrameworkElement::tHandle handle, tLoopbackChannel::tTimePoint now);
+
+  /*!
+   * Creates subscription of peer - or changes its filter
+   * (acquires runtime's structure mutex - so caller must not hold mutex)
+   *
+   * \param peer UUID of peer whose subscription message arrived
+   * \param filter Filter of structure subscription
+   */
+  void ProcessStructureSubscription(const tRuntimeId& peer, const structure_info::tStructureFilter& filter);
+
+  /*!
+   * Sends pending values - most urgent first - as long as the links are free (caller must hold mutex)
+   *
+   * \param now Current time
+   * \return True if a value was sent
+   */
+  bool SendPendingValues(tLoopbackChannel::tTimePoint now);
+
+  /*! Sends value of source port to connected peers (send function of port_value_routes) */
+  void SendPortValue(core::tFrameworkElement::tHandle handle, const std::vector<tPortValueRoutes::tRoute>& routes, const rrlib::rtti::tGenericObject& value);
+
+  /*!
+   * Sends info on structure to subscribed peers: batches that are ready - or all matching elements if peer needs a reset
+   * (acquires runtime's structure mutex - so caller must not hold mutex)
+   *
+   * \param now Current time
+   * \return True if a message was sent
+   */
+  bool SendStructureChanges(tLoopbackChannel::tTimePoint now);
+
+  /*! Starts or stops delivery thread */
+  void StartDeliveryThread();
+  void StopDeliveryThread();
+
+  /*!
+   * Adds or removes connection
+   * (caller must hold runtime's structure mutex)
+   *
+   * \return Error message - or empty string on success
+   */
+  std::string UpdateConnection(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, int remote_port_handle, bool add);
+
+  /*!
+   * Feeds current state of links to update rate controllers (caller must hold mutex)
+   *
+   * \param now Current time
+   */
+  void UpdateRateControllers(tLoopbackChannel::tTimePoint now);
+
+  virtual void OnEdgeChange(core::tRuntimeListener::tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target) override;
+  virtual void OnFrameworkElementChange(core::tRuntimeListener::tEvent change_type, core::tFrameworkElement& element) override;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,421 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/shared_memory/tSharedMemoryRingBuffer.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/shared_memory/tSharedMemoryRingBuffer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <signal.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace shared_memory
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Atomic 64 bit integers must be lock-free in order to be used in shared memory");
+
+/*!
+ * Header at the beginning of the shared memory object
+ */
+struct tSharedMemoryRingBuffer::tHeader
+{
+  /*! Magic number - set after header has been initialized */
+  std::atomic<uint32_t> magic;
+
+  /*! Capacity of data area (multiple of cALIGNMENT) */
+  uint64_t capacity;
+
+  /*! Process ID of reader (process that created the buffer) */
+  pid_t owner_pid;
+
+  /*! Mutex for writers (and for waiting for data) */
+  pthread_mutex_t mutex;
+
+  /*! Signalled when data has been written */
+  pthread_cond_t data_written;
+
+  /*! Total number of bytes written and read (offset in data area is position modulo capacity) */
+  std::atomic<uint64_t> write_position, read_position;
+};
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Magic number of initialized header */
+const uint32_t cMAGIC = 0x46534852; // "FSHR"
+
+/*! Alignment of messages in ring buffer */
+const size_t cALIGNMENT = 8;
+
+/*! Size of message header (message size) */
+const size_t cMESSAGE_HEADER_SIZE = sizeof(uint32_t);
+
+/*! Message size that marks unused space at end of data area (next message is at beginning) */
+const uint32_t cPADDING = 0xFFFFFFFF;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+size_t Align(size_t size)
+{
+  return (size + cALIGNMENT - 1) & ~(cALIGNMENT - 1);
+}
+
+std::runtime_error SystemError(const std::string& operation, const std::string& name)
+{
+  return std::runtime_error(operation + " of shared memory '" + name + "' failed: " + strerror(errno));
+}
+
+}
+
+tSharedMemoryRingBuffer::tSharedMemoryRingBuffer(const std::string& name, size_t capacity) :
+  name(name),
+  owner(true),
+  file_descriptor(-1),
+  memory(nullptr),
+  memory_size(0),
+  header(nullptr),
+  data(nullptr),
+  capacity(Align(std::max<size_t>(capacity, 1024)))
+{
+  file_descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (file_descriptor < 0 && errno == EEXIST && IsLeftover(name))
+  {
+    shm_unlink(name.c_str());
+    file_descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  }
+  if (file_descriptor < 0)
+  {
+    // Never remove the shared memory object of another process: this would silently disconnect it from all peers
+    throw SystemError("Creation", name);
+  }
+  size_t size = Align(sizeof(tHeader)) + this->capacity;
+  if (ftruncate(file_descriptor, size) != 0)
+  {
+    std::runtime_error error = SystemError("Resizing", name);
+    close(file_descriptor);
+    shm_unlink(name.c_str());
+    throw error;
+  }
+  Map(size);
+
+  new(header) tHeader();
+  header->capacity = this->capacity;
+  header->owner_pid = getpid();
+  header->write_position = 0;
+  header->read_position = 0;
+
+  pthread_mutexattr_t mutex_attributes;
+  pthread_mutexattr_init(&mutex_attributes);
+  pthread_mutexattr_setpshared(&mutex_attributes, PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust(&mutex_attributes, PTHREAD_MUTEX_ROBUST);
+  pthread_mutex_init(&header->mutex, &mutex_attributes);
+  pthread_mutexattr_destroy(&mutex_attributes);
+
+  pthread_condattr_t condition_attributes;
+  pthread_condattr_init(&condition_attributes);
+  pthread_condattr_setpshared(&condition_attributes, PTHREAD_PROCESS_SHARED);
+  pthread_condattr_setclock(&condition_attributes, CLOCK_MONOTONIC);
+  pthread_cond_init(&header->data_written, &condition_attributes);
+  pthread_condattr_destroy(&condition_attributes);
+
+  header->magic.store(cMAGIC, std::memory_order_release);
+}
+
+tSharedMemoryRingBuffer::tSharedMemoryRingBuffer(const std::string& name) :
+  name(name),
+  owner(false),
+  file_descriptor(-1),
+  memory(nullptr),
+  memory_size(0),
+  header(nullptr),
+  data(nullptr),
+  capacity(0)
+{
+  file_descriptor = shm_open(name.c_str(), O_RDWR, 0600);
+  if (file_descriptor < 0)
+  {
+    throw SystemError("Opening", name);
+  }
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0 || static_cast<size_t>(file_status.st_size) <= Align(sizeof(tHeader)))
+  {
+    close(file_descriptor);
+    throw std::runtime_error("Shared memory '" + name + "' has invalid size");
+  }
+  Map(file_status.st_size);
+  if (header->magic.load(std::memory_order_acquire) != cMAGIC || header->capacity + Align(sizeof(tHeader)) > memory_size)
+  {
+    munmap(memory, memory_size);
+    close(file_descriptor);
+    throw std::runtime_error("Shared memory '" + name + "' is not an initialized ring buffer");
+  }
+  capacity = header->capacity;
+}
+
+tSharedMemoryRingBuffer::~tSharedMemoryRingBuffer()
+{
+  if (owner)
+  {
+    header->magic.store(0, std::memory_order_release);
+    shm_unlink(name.c_str());
+  }
+  munmap(memory, memory_size);
+  close(file_descriptor);
+}
+
+bool tSharedMemoryRingBuffer::Exists(const std::string& name)
+{
+  int file_descriptor = shm_open(name.c_str(), O_RDONLY, 0600);
+  if (file_descriptor < 0)
+  {
+    return false;
+  }
+  close(file_descriptor);
+  return true;
+}
+
+size_t tSharedMemoryRingBuffer::GetCapacity() const
+{
+  return capacity;
+}
+
+size_t tSharedMemoryRingBuffer::GetMaxMessageSize() const
+{
+  return capacity / 2 - cMESSAGE_HEADER_SIZE;
+}
+
+bool tSharedMemoryRingBuffer::IsClosed() const
+{
+  return header->magic.load(std::memory_order_acquire) != cMAGIC;
+}
+
+bool tSharedMemoryRingBuffer::IsLeftover(const std::string& name)
+{
+  int file_descriptor = shm_open(name.c_str(), O_RDONLY, 0600);
+  if (file_descriptor < 0)
+  {
+    return false;
+  }
+  struct stat file_status;
+  bool leftover = false;
+  if (fstat(file_descriptor, &file_status) == 0 && static_cast<size_t>(file_status.st_size) >= sizeof(tHeader))
+  {
+    void* memory = mmap(nullptr, sizeof(tHeader), PROT_READ, MAP_SHARED, file_descriptor, 0);
+    if (memory != MAP_FAILED)
+    {
+      // Buffers that are not (yet) initialized might be in the process of being created - so they are not considered leftovers
+      const tHeader* header = static_cast<const tHeader*>(memory);
+      leftover = header->magic.load(std::memory_order_acquire) == cMAGIC && kill(header->owner_pid, 0) != 0 && errno == ESRCH;
+      munmap(memory, sizeof(tHeader));
+    }
+  }
+  close(file_descriptor);
+  return leftover;
+}
+
+void tSharedMemoryRingBuffer::LockMutex()
+{
+  if (pthread_mutex_lock(&header->mutex) == EOWNERDEAD)
+  {
+    // writer died while holding mutex - messages are written completely before write position is updated, so state is consistent
+    pthread_mutex_consistent(&header->mutex);
+  }
+}
+
+void tSharedMemoryRingBuffer::Map(size_t size)
+{
+  memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+  if (memory == MAP_FAILED)
+  {
+    std::runtime_error error = SystemError("Mapping", name);
+    close(file_descriptor);
+    if (owner)
+    {
+      shm_unlink(name.c_str());
+    }
+    throw error;
+  }
+  memory_size = size;
+  header = static_cast<tHeader*>(memory);
+  data = static_cast<char*>(memory) + Align(sizeof(tHeader));
+}
+
+size_t tSharedMemoryRingBuffer::Read(const tMessageHandler& handler, std::chrono::milliseconds timeout)
+{
+  assert(owner);
+  uint64_t read_position = header->read_position.load(std::memory_order_relaxed);
+  uint64_t write_position = header->write_position.load(std::memory_order_acquire);
+  if (read_position == write_position)
+  {
+    timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout.count() / 1000;
+    deadline.tv_nsec += (timeout.count() % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000;
+    }
+
+    LockMutex();
+    int result = 0;
+    while (result != ETIMEDOUT && (write_position = header->write_position.load(std::memory_order_acquire)) == read_position)
+    {
+      result = pthread_cond_timedwait(&header->data_written, &header->mutex, &deadline);
+      if (result == EOWNERDEAD)
+      {
+        pthread_mutex_consistent(&header->mutex);
+      }
+    }
+    pthread_mutex_unlock(&header->mutex);
+  }
+
+  size_t message_count = 0;
+  while (read_position != write_position)
+  {
+    // Positions and message sizes are written by other processes - so they are checked before they are used
+    size_t offset = read_position % capacity;
+    uint32_t size = 0;
+    bool valid = write_position - read_position <= capacity && offset % cALIGNMENT == 0;
+    if (valid)
+    {
+      memcpy(&size, data + offset, sizeof(size));
+    }
+    uint64_t next_position = read_position + (size == cPADDING ? capacity - offset : Align(cMESSAGE_HEADER_SIZE + size));
+    valid &= next_position <= write_position && (size == cPADDING || (size <= GetMaxMessageSize() && offset + cMESSAGE_HEADER_SIZE + size <= capacity));
+    if (!valid)
+    {
+      header->read_position.store(write_position, std::memory_order_release);
+      throw std::runtime_error("Ring buffer '" + name + "' contains invalid message header. Discarding its content.");
+    }
+    if (size == cPADDING)
+    {
+      read_position = next_position;
+      continue;
+    }
+    handler(data + offset + cMESSAGE_HEADER_SIZE, size);
+    read_position = next_position;
+    header->read_position.store(read_position, std::memory_order_release);
+    message_count++;
+  }
+  header->read_position.store(read_position, std::memory_order_release);
+  return message_count;
+}
+
+bool tSharedMemoryRingBuffer::Write(const void* message, size_t size)
+{
+  return Write(nullptr, 0, message, size);
+}
+
+bool tSharedMemoryRingBuffer::Write(const void* prefix, size_t prefix_size, const void* message, size_t size)
+{
+  size += prefix_size;
+  if (size > GetMaxMessageSize())
+  {
+    return false;
+  }
+  size_t record_size = Align(cMESSAGE_HEADER_SIZE + size);
+
+  LockMutex();
+  uint64_t write_position = header->write_position.load(std::memory_order_relaxed);
+  uint64_t read_position = header->read_position.load(std::memory_order_acquire);
+  size_t offset = write_position % capacity;
+  size_t contiguous = capacity - offset;
+  size_t padding = record_size > contiguous ? contiguous : 0;
+  if (write_position + padding + record_size - read_position > capacity)
+  {
+    pthread_mutex_unlock(&header->mutex);
+    return false;
+  }
+  if (padding)
+  {
+    memcpy(data + offset, &cPADDING, sizeof(cPADDING));
+    write_position += padding;
+    offset = 0;
+  }
+  uint32_t message_size = static_cast<uint32_t>(size);
+  memcpy(data + offset, &message_size, sizeof(message_size));
+  if (prefix_size)
+  {
+    memcpy(data + offset + cMESSAGE_HEADER_SIZE, prefix, prefix_size);
+  }
+  memcpy(data + offset + cMESSAGE_HEADER_SIZE + prefix_size, message, size - prefix_size);
+  header->write_position.store(write_position + record_size, std::memory_order_release);
+  pthread_cond_signal(&header->data_written);
+  pthread_mutex_unlock(&header->mutex);
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,222 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/shared_memory/tSharedMemoryRingBuffer.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tSharedMemoryRingBuffer
+ *
+ * \b tSharedMemoryRingBuffer
+ *
+ * Message ring buffer in POSIX shared memory for communication among
+ * processes on the same host. There is one reader (the process that created
+ * the buffer) and any number of writers. Messages are stored contiguously,
+ * so that the reader can deserialize them directly from shared memory.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__shared_memory__tSharedMemoryRingBuffer_h__
+#define __plugins__network_transport__shared_memory__tSharedMemoryRingBuffer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <chrono>
+#include <functional>
+#include <string>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace shared_memory
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Message ring buffer in shared memory
+/*!
+ * Ring buffer for variable-size messages in a POSIX shared memory object.
+ *
+ * The process that creates the buffer is the only reader. Any number of processes
+ * may open the buffer and write messages to it. Writers are synchronized using a
+ * process-shared (robust) mutex - which is also used to wake up the reader.
+ * Read and write positions are atomic, so the reader does not need to lock the
+ * mutex while there is data to read. The reader checks every message header against
+ * the buffer's capacity - so a misbehaving writer cannot make it read outside the buffer.
+ *
+ * Throws std::runtime_error if shared memory cannot be created or opened.
+ */
+class tSharedMemoryRingBuffer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Handler for messages that are read (receives pointer to message in shared memory and message size) */
+  typedef std::function<void (const char* message, size_t size)> tMessageHandler;
+
+  /*!
+   * Creates new ring buffer (this process will be the reader).
+   * If a shared memory object with the same name exists, creation fails - unless it is a
+   * leftover of a process that has terminated without removing it (it is replaced then).
+   *
+   * \param name Name of shared memory object (must start with '/')
+   * \param capacity Capacity of ring buffer in bytes
+   */
+  tSharedMemoryRingBuffer(const std::string& name, size_t capacity);
+
+  /*!
+   * Opens existing ring buffer (this process will be a writer)
+   *
+   * \param name Name of shared memory object (must start with '/')
+   */
+  explicit tSharedMemoryRingBuffer(const std::string& name);
+
+  ~tSharedMemoryRingBuffer();
+
+  /*!
+   * \param name Name of shared memory object
+   * \return True if a shared memory object with this name exists (e.g. reader has created ring buffer)
+   */
+  static bool Exists(const std::string& name);
+
+  /*!
+   * \return Capacity of ring buffer in bytes
+   */
+  size_t GetCapacity() const;
+
+  /*!
+   * \return Name of shared memory object
+   */
+  const std::string& GetName() const
+  {
+    return name;
+  }
+
+  /*!
+   * \return Maximum size of a single message
+   */
+  size_t GetMaxMessageSize() const;
+
+  /*!
+   * \return True if reader has closed the buffer (writers should reopen it then - as reader may have been restarted)
+   */
+  bool IsClosed() const;
+
+  /*!
+   * Reads all messages that are currently available.
+   * Waits for messages if there are none.
+   * May only be called by the process that created the buffer.
+   *
+   * \param handler Handler to call for every message. The message pointer is only valid during the call.
+   * \param timeout Maximum time to wait for messages
+   * \return Number of messages read
+   * \throw std::runtime_error if a message header is invalid (all data currently in the buffer is discarded then)
+   */
+  size_t Read(const tMessageHandler& handler, std::chrono::milliseconds timeout);
+
+  /*!
+   * Writes message to ring buffer.
+   *
+   * \param message Pointer to message data
+   * \param size Size of message
+   * \return True if message was written. False if there is not enough free space (message is dropped then).
+   */
+  bool Write(const void* message, size_t size);
+
+  /*!
+   * Writes message that consists of two parts to ring buffer
+   * (e.g. a header and a payload that is sent to multiple readers - so that it does not need to be copied to a contiguous buffer first).
+   *
+   * \param prefix Pointer to first part of message
+   * \param prefix_size Size of first part of message
+   * \param message Pointer to second part of message
+   * \param size Size of second part of message
+   * \return True if message was written. False if there is not enough free space (message is dropped then).
+   */
+  bool Write(const void* prefix, size_t prefix_size, const void* message, size_t size);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tHeader;
+
+  /*! Name of shared memory object */
+  std::string name;
+
+  /*! Did this process create the shared memory object? (reader) */
+  bool owner;
+
+  /*! File descriptor of shared memory object */
+  int file_descriptor;
+
+  /*! Mapped shared memory and its size */
+  void* memory;
+  size_t memory_size;
+
+  /*! Header and data in shared memory */
+  tHeader* header;
+  char* data;
+
+  /*! Capacity of data area (copy of value in header - which is not trusted by the reader, as any writer could modify it) */
+  size_t capacity;
+
+  /*!
+   * \param name Name of shared memory object
+   * \return True if shared memory object with this name was created by a process that has terminated without removing it
+   */
+  static bool IsLeftover(const std::string& name);
+
+  /*! Locks header's mutex (recovers it, if previous owner died) */
+  void LockMutex();
+
+  /*! Maps shared memory (after file descriptor has been obtained) */
+  void Map(size_t size);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,443 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/shared_memory/tSharedMemoryTransport.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/shared_memory/tSharedMemoryTransport.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdio>
+#include <unistd.h>
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkConnections.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace shared_memory
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+const std::chrono::nanoseconds tSharedMemoryTransport::cESTIMATED_LATENCY = std::chrono::microseconds(10);
+
+/*! Maximum time receive thread waits for messages before checking whether it should stop */
+const std::chrono::milliseconds cRECEIVE_TIMEOUT(100);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Plugin instance (shared memory transport is a separate library - so it is only available if this library is loaded) */
+static tSharedMemoryTransport plugin;
+
+namespace
+{
+
+std::string GetDefaultRuntimeUuid()
+{
+  char hostname[256] = { 0 };
+  gethostname(hostname, sizeof(hostname) - 1);
+  return std::string(hostname) + ":" + std::to_string(getpid());
+}
+
+/*!
+ * \param port Port
+ * \param link Link (qualified - with or without leading slash)
+ * \return Whether port has specified link
+ */
+bool HasLink(core::tAbstractPort& port, const std::string& link)
+{
+  std::string qualified_link;
+  for (size_t i = 0; i < port.GetLinkCount(); i++)
+  {
+    port.GetQualifiedLink(qualified_link, i);
+    if (qualified_link == link || (qualified_link.length() && link[0] != '/' && qualified_link.compare(1, std::string::npos, link) == 0))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * Checks whether local port may be connected to port of peer
+ *
+ * \param local_port Local port
+ * \param remote_type Data type of peer's port
+ * \param local_port_link Link of local port as specified by peer (empty if not specified)
+ * \param remote_port_is_source Is peer's port the source of the connection?
+ * \return Error message - or empty string if ports may be connected
+ */
+std::string CheckConnection(core::tAbstractPort& local_port, const rrlib::rtti::tType& remote_type, const std::string& local_port_link, bool remote_port_is_source)
+{
+  if (!data_ports::IsDataFlowType(local_port.GetDataType()))
+  {
+    return "Port '" + local_port.GetName() + "' is no data port";
+  }
+  if (local_port.GetDataType() != remote_type)
+  {
+    return std::string("Data types of ports differ (local: ") + local_port.GetDataType().GetName() + ", remote: " + remote_type.GetName() + ")";
+  }
+  if (local_port.IsOutputPort() == remote_port_is_source)
+  {
+    return remote_port_is_source ? "Both ports are output ports" : "Both ports are input ports";
+  }
+  if (local_port_link.length() && (!HasLink(local_port, local_port_link)))
+  {
+    return "Port '" + local_port.GetName() + "' does not have link '" + local_port_link + "'";
+  }
+  return "";
+}
+
+}
+
+tSharedMemoryTransport::tSharedMemoryTransport() :
+  tNetworkTransportPlugin("shared_memory"),
+  mutex(),
+  local_runtime_uuid(GetDefaultRuntimeUuid()),
+  inbox(),
+  outboxes(),
+  receive_thread(),
+  stop_receive_thread(false),
+  port_value_routes(std::bind(&tSharedMemoryTransport::SendPortValue, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3))
+{}
+
+void tSharedMemoryTransport::AddConnection(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, core::tFrameworkElement::tHandle remote_handle, bool local_port_is_source)
+{
+  tNetworkConnections* connections = local_port.GetAnnotation<tNetworkConnections>();
+  if (!connections)
+  {
+    connections = new tNetworkConnections();
+    local_port.AddAnnotation(connections);
+  }
+  connections->Add(tNetworkConnection(remote_runtime_uuid, remote_handle, !local_port_is_source));
+
+  if (local_port_is_source)
+  {
+    port_value_routes.Add(local_port, tPortValueRoutes::tRoute { tRuntimeId(remote_runtime_uuid), remote_handle });
+  }
+}
+
+std::string tSharedMemoryTransport::Connect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+    int remote_port_handle, const std::string remote_port_link)
+{
+  if (!data_ports::IsDataFlowType(local_port.GetDataType()))
+  {
+    return "Only data ports can be connected via shared memory";
+  }
+  std::string error = SendConnectionMessage(tOpCode::CONNECT, local_port, remote_runtime_uuid, remote_port_handle, remote_port_link);
+  if (error.length())
+  {
+    return error;
+  }
+  rrlib::thread::tLock lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  AddConnection(local_port, remote_runtime_uuid, remote_port_handle, local_port.IsOutputPort());
+  return "";
+}
+
+std::string tSharedMemoryTransport::Disconnect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+    int remote_port_handle, const std::string remote_port_link)
+{
+  std::string error = SendConnectionMessage(tOpCode::DISCONNECT, local_port, remote_runtime_uuid, remote_port_handle, remote_port_link);
+  rrlib::thread::tLock lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  RemoveConnection(local_port, remote_runtime_uuid, remote_port_handle, local_port.IsOutputPort());
+  return error;
+}
+
+tTransportCost tSharedMemoryTransport::EstimateCost(const tRuntimeId& remote_runtime) const
+{
+  {
+    rrlib::thread::tLock lock(mutex);
+    if (!inbox)
+    {
+      return tTransportCost(tTransportCost::tReachability::UNREACHABLE, cESTIMATED_LATENCY, cESTIMATED_BANDWIDTH);
+    }
+  }
+  bool reachable = tSharedMemoryRingBuffer::Exists(GetInboxName(remote_runtime));
+  return tTransportCost(reachable ? tTransportCost::tReachability::REACHABLE : tTransportCost::tReachability::UNREACHABLE, cESTIMATED_LATENCY, cESTIMATED_BANDWIDTH);
+}
+
+std::string tSharedMemoryTransport::GetInboxName(const tRuntimeId& uuid)
+{
+  char name[64];
+  snprintf(name, sizeof(name), "/finroc_shm_%016llx%016llx", static_cast<unsigned long long>(uuid.GetHigh()), static_cast<unsigned long long>(uuid.GetLow()));
+  return name;
+}
+
+std::string tSharedMemoryTransport::GetLocalRuntimeUuid() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return local_runtime_uuid;
+}
+
+void tSharedMemoryTransport::Init(rrlib::xml::tNode* config_node)
+{
+  rrlib::thread::tLock lock(mutex);
+  try
+  {
+    inbox.reset(new tSharedMemoryRingBuffer(GetInboxName(tRuntimeId(local_runtime_uuid)), cDEFAULT_INBOX_CAPACITY));
+  }
+  catch (const std::exception& e)
+  {
+    FINROC_LOG_PRINT(ERROR, "Could not create inbox. Shared memory transport is not available: ", e.what());
+    return;
+  }
+  core::tRuntimeEnvironment::GetInstance().AddListener(*this);
+  receive_thread = std::thread(&tSharedMemoryTransport::ReceiveLoop, this);
+  RegisterShutdownHook();
+}
+
+void tSharedMemoryTransport::OnEdgeChange(core::tRuntimeListener::tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target)
+{
+}
+
+void tSharedMemoryTransport::OnFrameworkElementChange(core::tRuntimeListener::tEvent change_type, core::tFrameworkElement& element)
+{
+  if (change_type == core::tRuntimeListener::tEvent::REMOVE && element.IsPort())
+  {
+    port_value_routes.RemovePort(static_cast<core::tAbstractPort&>(element));
+  }
+}
+
+void tSharedMemoryTransport::ProcessMessage(const char* message, size_t size)
+{
+  rrlib::serialization::tMemoryBuffer buffer(const_cast<char*>(message), size);
+  rrlib::serialization::tInputStream stream(buffer);
+  tOpCode opcode = static_cast<tOpCode>(stream.ReadByte());
+  switch (opcode)
+  {
+  case tOpCode::CONNECT:
+  case tOpCode::DISCONNECT:
+  {
+    std::string sender_uuid = stream.ReadString();
+    core::tFrameworkElement::tHandle sender_handle = stream.ReadInt();
+    core::tFrameworkElement::tHandle receiver_handle = stream.ReadInt();
+    bool sender_is_source = stream.ReadBoolean();
+    rrlib::rtti::tType sender_type;
+    stream >> sender_type;
+    std::string receiver_link = stream.ReadString();
+    rrlib::thread::tLock lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+    core::tAbstractPort* port = core::tRuntimeEnvironment::GetInstance().GetPort(receiver_handle);
+    if (!port)
+    {
+      FINROC_LOG_PRINT(WARNING, "Received connection request for port that does not exist (handle ", receiver_handle, ")");
+      return;
+    }
+    if (opcode == tOpCode::CONNECT)
+    {
+      std::string error = CheckConnection(*port, sender_type, receiver_link, sender_is_source);
+      if (error.length())
+      {
+        FINROC_LOG_PRINT(WARNING, "Rejecting connection request from runtime environment '", sender_uuid, "': ", error);
+        return;
+      }
+      AddConnection(*port, sender_uuid, sender_handle, !sender_is_source);
+    }
+    else
+    {
+      RemoveConnection(*port, sender_uuid, sender_handle, !sender_is_source);
+    }
+    break;
+  }
+  case tOpCode::PORT_VALUE:
+  {
+    core::tFrameworkElement::tHandle handle = stream.ReadInt();
+    tPortValueRoutes::PublishValue(handle, stream);
+    break;
+  }
+  default:
+    FINROC_LOG_PRINT(WARNING, "Received message with invalid opcode ", static_cast<int>(opcode));
+  }
+}
+
+void tSharedMemoryTransport::ReceiveLoop()
+{
+  while (!stop_receive_thread)
+  {
+    try
+    {
+      inbox->Read([this](const char* message, size_t size)
+      {
+        try
+        {
+          ProcessMessage(message, size);
+        }
+        catch (const std::exception& e)
+        {
+          FINROC_LOG_PRINT(WARNING, "Dropping message that could not be processed: ", e.what());
+        }
+      }, cRECEIVE_TIMEOUT);
+    }
+    catch (const std::exception& e)
+    {
+      FINROC_LOG_PRINT(WARNING, e.what());
+    }
+  }
+}
+
+void tSharedMemoryTransport::RemoveConnection(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, core::tFrameworkElement::tHandle remote_handle, bool local_port_is_source)
+{
+  tNetworkConnections* connections = local_port.GetAnnotation<tNetworkConnections>();
+  if (connections)
+  {
+    connections->Remove(tNetworkConnection(remote_runtime_uuid, remote_handle, !local_port_is_source));
+  }
+
+  if (local_port_is_source)
+  {
+    port_value_routes.Remove(local_port, tPortValueRoutes::tRoute { tRuntimeId(remote_runtime_uuid), remote_handle });
+  }
+}
+
+std::string tSharedMemoryTransport::Send(const tRuntimeId& peer, rrlib::serialization::tMemoryBuffer& message, rrlib::serialization::tMemoryBuffer* payload)
+{
+  auto it = outboxes.find(peer);
+  if (it != outboxes.end() && it->second->IsClosed())
+  {
+    outboxes.erase(it);  // peer was restarted or has terminated
+    it = outboxes.end();
+  }
+  if (it == outboxes.end())
+  {
+    try
+    {
+      it = outboxes.emplace(peer, std::unique_ptr<tSharedMemoryRingBuffer>(new tSharedMemoryRingBuffer(GetInboxName(peer)))).first;
+    }
+    catch (const std::exception& e)
+    {
+      return std::string("Runtime environment is not reachable via shared memory: ") + e.what();
+    }
+  }
+  bool written = payload ? it->second->Write(message.GetBufferPointer(0), message.GetSize(), payload->GetBufferPointer(0), payload->GetSize()) :
+                 it->second->Write(message.GetBufferPointer(0), message.GetSize());
+  if (!written)
+  {
+    return "Inbox of runtime environment is full or message is too large. Message was dropped.";
+  }
+  return "";
+}
+
+std::string tSharedMemoryTransport::SendConnectionMessage(tOpCode opcode, core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, int remote_port_handle, const std::string& remote_port_link)
+{
+  rrlib::serialization::tMemoryBuffer buffer;
+  rrlib::serialization::tOutputStream stream(buffer);
+  stream.WriteByte(static_cast<uint8_t>(opcode));
+  stream << GetLocalRuntimeUuid();
+  stream.WriteInt(local_port.GetHandle());
+  stream.WriteInt(remote_port_handle);
+  stream.WriteBoolean(local_port.IsOutputPort());
+  stream << local_port.GetDataType() << remote_port_link;
+  stream.Close();
+
+  rrlib::thread::tLock lock(mutex);
+  if (!inbox)
+  {
+    return "Shared memory transport is not initialized";
+  }
+  return Send(tRuntimeId(remote_runtime_uuid), buffer);
+}
+
+void tSharedMemoryTransport::SendPortValue(core::tFrameworkElement::tHandle handle, const std::vector<tPortValueRoutes::tRoute>& routes, const rrlib::rtti::tGenericObject& value)
+{
+  // Value is serialized once - and written to the inboxes of all peers behind a header with the peer's port handle
+  thread_local rrlib::serialization::tMemoryBuffer header_buffer, value_buffer;
+  {
+    rrlib::serialization::tOutputStream stream(value_buffer);
+    value.Serialize(stream);
+    stream.Close();
+  }
+  rrlib::thread::tLock lock(mutex);
+  for (const tPortValueRoutes::tRoute & route : routes)
+  {
+    rrlib::serialization::tOutputStream stream(header_buffer);
+    stream.WriteByte(static_cast<uint8_t>(tOpCode::PORT_VALUE));
+    stream.WriteInt(route.remote_handle);
+    stream.Close();
+    std::string error = Send(route.peer, header_buffer, &value_buffer);
+    if (error.length())
+    {
+      FINROC_LOG_PRINT(DEBUG_WARNING, "Could not send value of port ", handle, ": ", error);
+    }
+  }
+}
+
+void tSharedMemoryTransport::Shutdown()
+{
+  if (receive_thread.joinable())
+  {
+    stop_receive_thread = true;
+    receive_thread.join();
+    core::tRuntimeEnvironment::GetInstance().RemoveListener(*this);
+  }
+  rrlib::thread::tLock lock(mutex);
+  outboxes.clear();
+  inbox.reset();
+}
+
+void tSharedMemoryTransport::SetLocalRuntimeUuid(const std::string& uuid)
+{
+  rrlib::thread::tLock lock(mutex);
+  if (inbox)
+  {
+    FINROC_LOG_PRINT(WARNING, "Runtime UUID must be set before plugin is initialized. Ignoring.");
+    return;
+  }
+  local_runtime_uuid = uuid;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,230 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/shared_memory/tSharedMemoryTransport.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tSharedMemoryTransport
+ *
+ * \b tSharedMemoryTransport
+ *
+ * Network transport for runtime environments on the same host.
+ * Port values are exchanged via ring buffers in POSIX shared memory instead
+ * of a network socket.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__shared_memory__tSharedMemoryTransport_h__
+#define __plugins__network_transport__shared_memory__tSharedMemoryTransport_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include "core/tRuntimeEnvironment.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkTransportPlugin.h"
+#include "plugins/network_transport/tPortValueRoutes.h"
+#include "plugins/network_transport/shared_memory/tSharedMemoryRingBuffer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace shared_memory
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Shared memory transport
+/*!
+ * Network transport plugin for runtime environments on the same host.
+ *
+ * Every runtime environment creates an inbox (tSharedMemoryRingBuffer) whose
+ * name is derived from its runtime UUID. Peers write connect/disconnect requests
+ * and port values to this inbox. A receive thread deserializes messages
+ * directly from shared memory and publishes values to the local ports.
+ * A published value is serialized once (into a thread-local buffer) and copied
+ * once into the inbox of every connected peer - behind a small per-peer header.
+ * Apart from waking up the receive thread, the kernel is not involved.
+ *
+ * Connection requests are checked by the receiving runtime environment: the
+ * receiving port must be a data port with the sender port's data type and
+ * opposite direction (and have the link specified by the sender, if any).
+ * Invalid requests are rejected with a warning.
+ *
+ * Connections are stored in the ports' tNetworkConnections annotations - as
+ * with any other network transport.
+ *
+ * The local runtime UUID must be set using SetLocalRuntimeUuid() before the
+ * plugin is initialized (typically, the UUID used by other transports, so that
+ * tools can address this runtime environment with the same UUID).
+ */
+class tSharedMemoryTransport : public tNetworkTransportPlugin, public core::tRuntimeListener
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Default capacity of inbox in bytes */
+  enum { cDEFAULT_INBOX_CAPACITY = 4 * 1024 * 1024 };
+
+  /*! Estimated latency and bandwidth of shared memory transport (reported by EstimateCost()) */
+  static const std::chrono::nanoseconds cESTIMATED_LATENCY;
+  static const uint64_t cESTIMATED_BANDWIDTH = 2000000000;
+
+  tSharedMemoryTransport();
+
+  virtual std::string Connect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+                              int remote_port_handle, const std::string remote_port_link) override;
+
+  virtual std::string Disconnect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
+                                 int remote_port_handle, const std::string remote_port_link) override;
+
+  /*!
+   * Runtime environments are reachable if their inbox exists on this host
+   */
+  virtual tTransportCost EstimateCost(const tRuntimeId& remote_runtime) const override;
+
+  /*!
+   * \return UUID of local runtime environment as used by this transport
+   */
+  std::string GetLocalRuntimeUuid() const;
+
+  /*!
+   * \param uuid Identifier of runtime environment
+   * \return Name of shared memory object used as inbox by specified runtime environment
+   */
+  static std::string GetInboxName(const tRuntimeId& uuid);
+
+  virtual void Init(rrlib::xml::tNode* config_node) override;
+
+  /*!
+   * Sets UUID of local runtime environment (must be called before plugin is initialized)
+   *
+   * \param uuid UUID of local runtime environment
+   */
+  void SetLocalRuntimeUuid(const std::string& uuid);
+
+  /*!
+   * Stops receive thread, unregisters from runtime environment and removes inbox
+   */
+  virtual void Shutdown() override;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Types of messages written to inboxes */
+  enum class tOpCode : uint8_t
+  {
+    CONNECT,     //!< Connect ports (sender UUID, sender port handle, receiver port handle, whether sender port is source, sender port data type, receiver port link)
+    DISCONNECT,  //!< Disconnect ports (same content as CONNECT)
+    PORT_VALUE   //!< New value for port (receiver port handle, serialized value)
+  };
+
+  /*! Mutex for all variables below (acquire after runtime's structure mutex and mutex of port_value_routes) */
+  mutable rrlib::thread::tMutex mutex;
+
+  /*! UUID of local runtime environment */
+  std::string local_runtime_uuid;
+
+  /*! Inbox of this runtime environment */
+  std::unique_ptr<tSharedMemoryRingBuffer> inbox;
+
+  /*! Inboxes of peers (opened on demand) */
+  std::unordered_map<tRuntimeId, std::unique_ptr<tSharedMemoryRingBuffer>> outboxes;
+
+  /*! Thread reading inbox */
+  std::thread receive_thread;
+
+  /*! Set to stop receive thread */
+  std::atomic<bool> stop_receive_thread;
+
+  /*! Destinations of values of local source ports */
+  tPortValueRoutes port_value_routes;
+
+
+  /*!
+   * Adds connection to annotation of local port (and route if local port is source)
+   * (caller must hold runtime's structure mutex)
+   */
+  void AddConnection(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, core::tFrameworkElement::tHandle remote_handle, bool local_port_is_source);
+
+  /*! Processes message read from inbox */
+  void ProcessMessage(const char* message, size_t size);
+
+  /*! Receive thread main loop */
+  void ReceiveLoop();
+
+  /*!
+   * Removes connection from annotation of local port (and route if local port is source)
+   * (caller must hold runtime's structure mutex)
+   */
+  void RemoveConnection(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, core::tFrameworkElement::tHandle remote_handle, bool local_port_is_source);
+
+  /*!
+   * Writes message to inbox of peer (caller must hold mutex)
+   *
+   * \param peer Peer to send message to
+   * \param message Message (or first part of message if payload is specified)
+   * \param payload Second part of message (optional)
+   * \return Error message - or empty string on success
+   */
+  std::string Send(const tRuntimeId& peer, rrlib::serialization::tMemoryBuffer& message, rrlib::serialization::tMemoryBuffer* payload = nullptr);
+
+  /*! Sends connect or disconnect message to peer */
+  std::string SendConnectionMessage(tOpCode opcode, core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, int remote_port_handle, const std::string& remote_port_link);
+
+  /*! Sends value of local source port to connected peers (send function of port_value_routes) */
+  void SendPortValue(core::tFrameworkElement::tHandle handle, const std::vector<tPortValueRoutes::tRoute>& routes, const rrlib::rtti::tGenericObject& value);
+
+  virtual void OnEdgeChange(core::tRuntimeListener::tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target) override;
+  virtual void OnFrameworkElementChange(core::tRuntimeListener::tEvent change_type, core::tFrameworkElement& element) override;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -44,6 +44,8 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/network_transport/tQualityOfService.h"
+#include "plugins/network_transport/structure_info/tStructureEncoding.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -63,7 +65,7 @@ namespace network_transport
 //! Inconstant port information
 /*!
  * Information about ports that may change during application runtime
- * (e.g. push/pull strategy, network update times)
+ * (e.g. push/pull strategy, network update times, quality of service)
  */
 struct tChangeablePortInfo
 {
@@ -73,29 +75,179 @@ struct tChangeablePortInfo
   /*! Strategy to use for this port - if it is destination port */
   int16_t strategy;
 
-  /*! Minimum network update interval */
+  /*! Minimum network update interval (0 for ports that are no data flow ports - as in the original format) */
   int16_t min_net_update_time;
 
+  /*! Quality of service settings (only exchanged with QOS_INFO encoding) */
+  tQualityOfService quality_of_service;
+
 
   tChangeablePortInfo() :
     flags(),
     strategy(0),
-    min_net_update_time(-1)
+    min_net_update_time(-1),
+    quality_of_service()
   {}
+
+  /*!
+   * Serializes framework element flags using specified optional encodings
+   * (with COMPACT_FLAGS: first and last 8 bits - followed by the 16 bits in between only for ports,
+   *  as these bits are only relevant for ports (the PORT flag itself is among the first 8 bits);
+   *  otherwise all 32 bits)
+   *
+   * \param stream Binary stream to serialize to
+   * \param flags Flags to serialize
+   * \param encoding Optional encodings to use
+   */
+  static void SerializeFlags(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement::tFlags flags, tStructureEncodingFlags encoding)
+  {
+    uint32_t raw_flags = flags.Raw();
+    if (!encoding.Get(tStructureEncodingFlag::COMPACT_FLAGS))
+    {
+      stream << raw_flags;
+      return;
+    }
+    stream << static_cast<uint8_t>(raw_flags & 0xFF) << static_cast<uint8_t>(raw_flags >> 24);
+    if (flags.Get(core::tFrameworkElement::tFlag::PORT))
+    {
+      stream << static_cast<uint16_t>((raw_flags >> 8) & 0xFFFF);
+    }
+  }
+
+  /*!
+   * Deserializes framework element flags that were serialized with SerializeFlags()
+   *
+   * \param stream Binary stream to deserialize from
+   * \param encoding Optional encodings used
+   * \return Deserialized flags
+   */
+  static core::tFrameworkElement::tFlags DeserializeFlags(rrlib::serialization::tInputStream& stream, tStructureEncodingFlags encoding)
+  {
+    uint32_t raw_flags = 0;
+    if (!encoding.Get(tStructureEncodingFlag::COMPACT_FLAGS))
+    {
+      stream >> raw_flags;
+      return core::tFrameworkElement::tFlags(raw_flags);
+    }
+    uint8_t first_bits = 0, last_bits = 0;
+    stream >> first_bits >> last_bits;
+    raw_flags = static_cast<uint32_t>(first_bits) | (static_cast<uint32_t>(last_bits) << 24);
+    core::tFrameworkElement::tFlags flags(raw_flags);
+    if (flags.Get(core::tFrameworkElement::tFlag::PORT))
+    {
+      uint16_t middle_bits = 0;
+      stream >> middle_bits;
+      flags = core::tFrameworkElement::tFlags(raw_flags | (static_cast<uint32_t>(middle_bits) << 8));
+    }
+    return flags;
+  }
+
+  /*!
+   * Serializes info using specified optional encodings
+   * (with COMPACT_FLAGS: flags as described in SerializeFlags(), followed by a byte
+   *  that indicates which of the non-default values strategy, min_net_update_time,
+   *  priority and latency budget follow;
+   *  with QOS_INFO only: priority and latency budget are appended)
+   *
+   * \param stream Binary stream to serialize to
+   * \param encoding Optional encodings to use
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, tStructureEncodingFlags encoding) const
+  {
+    if (!encoding.Get(tStructureEncodingFlag::COMPACT_FLAGS))
+    {
+      stream << flags.Raw() << strategy << min_net_update_time;
+      if (encoding.Get(tStructureEncodingFlag::QOS_INFO))
+      {
+        stream << static_cast<uint8_t>(quality_of_service.priority) << quality_of_service.latency_budget;
+      }
+      return;
+    }
+
+    tChangeablePortInfo defaults;
+    uint8_t non_default_values = (strategy != defaults.strategy ? 1 : 0) | (min_net_update_time != defaults.min_net_update_time ? 2 : 0);
+    if (encoding.Get(tStructureEncodingFlag::QOS_INFO))
+    {
+      non_default_values |= (quality_of_service.priority != defaults.quality_of_service.priority ? 4 : 0) |
+                            (quality_of_service.latency_budget != defaults.quality_of_service.latency_budget ? 8 : 0);
+    }
+    SerializeFlags(stream, flags, encoding);
+    stream.WriteByte(non_default_values);
+    if (non_default_values & 1)
+    {
+      stream << strategy;
+    }
+    if (non_default_values & 2)
+    {
+      stream << min_net_update_time;
+    }
+    if (non_default_values & 4)
+    {
+      stream << static_cast<uint8_t>(quality_of_service.priority);
+    }
+    if (non_default_values & 8)
+    {
+      stream << quality_of_service.latency_budget;
+    }
+  }
+
+  /*!
+   * Deserializes info that was serialized using specified optional encodings
+   *
+   * \param stream Binary stream to deserialize from
+   * \param encoding Optional encodings used
+   */
+  void Deserialize(rrlib::serialization::tInputStream& stream, tStructureEncodingFlags encoding)
+  {
+    if (!encoding.Get(tStructureEncodingFlag::COMPACT_FLAGS))
+    {
+      uint32_t raw_flags;
+      stream >> raw_flags;
+      flags = core::tFrameworkElement::tFlags(raw_flags);
+      stream >> strategy >> min_net_update_time;
+      quality_of_service = tQualityOfService();
+      if (encoding.Get(tStructureEncodingFlag::QOS_INFO))
+      {
+        quality_of_service.priority = tQualityOfService::ToPortPriority(stream.ReadByte());
+        stream >> quality_of_service.latency_budget;
+      }
+      return;
+    }
+
+    tChangeablePortInfo defaults;
+    flags = DeserializeFlags(stream, encoding);
+    uint8_t non_default_values = static_cast<uint8_t>(stream.ReadByte());
+    strategy = defaults.strategy;
+    min_net_update_time = defaults.min_net_update_time;
+    quality_of_service = defaults.quality_of_service;
+    if (non_default_values & 1)
+    {
+      stream >> strategy;
+    }
+    if (non_default_values & 2)
+    {
+      stream >> min_net_update_time;
+    }
+    if (non_default_values & 4)
+    {
+      quality_of_service.priority = tQualityOfService::ToPortPriority(stream.ReadByte());
+    }
+    if (non_default_values & 8)
+    {
+      stream >> quality_of_service.latency_budget;
+    }
+  }
 };
 
 inline rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tChangeablePortInfo& info)
 {
-  stream << info.flags.Raw() << info.strategy << info.min_net_update_time;
+  info.Serialize(stream, tStructureEncodingFlags());
   return stream;
 }
 
 inline rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tChangeablePortInfo& info)
 {
-  uint32_t flags;
-  stream >> flags;
-  info.flags = core::tFrameworkElement::tFlags(flags);
-  stream >> info.strategy >> info.min_net_update_time;
+  info.Deserialize(stream, tStructureEncodingFlags());
   return stream;
 }
 
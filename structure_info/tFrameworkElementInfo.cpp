@@ -32,6 +32,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
 #include "core/tFrameworkElementTags.h"
 #include "plugins/data_ports/common/tAbstractDataPort.h"
 #include "plugins/network_transport/tNetworkConnections.h"
@@ -80,25 +81,63 @@ tFrameworkElementInfo::tFrameworkElementInfo() :
 
 void tFrameworkElementInfo::Deserialize(rrlib::serialization::tInputStream& stream)
 {
-  link_count = stream.ReadByte();
-  for (int i = 0; i < link_count; i++)
+  tStructureEncodingState default_encoding;
+  Deserialize(stream, default_encoding);
+}
+
+void tFrameworkElementInfo::Deserialize(rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state)
+{
+  bool front_coding = encoding_state.flags.Get(tStructureEncodingFlag::LINK_FRONT_CODING);
+  link_count = DeserializeLinks(stream, encoding_state, [&](size_t prefix_length)
+  {
+    std::string name(encoding_state.previous_link, 0, prefix_length);
+    name += stream.ReadString();
+    if (front_coding)
+    {
+      encoding_state.previous_link = name;
+    }
+    return name;
+  },
+  [this](size_t index, std::string & name, bool unique)
+  {
+    links[index] = { std::move(name), unique };
+  });
+
+  stream >> type;
+  changeable_info.Deserialize(stream, encoding_state.flags);
+}
+
+tChangeablePortInfo tFrameworkElementInfo::GetChangeableInfo(core::tFrameworkElement& framework_element)
+{
+  tChangeablePortInfo changeable_info;
+  changeable_info.flags = framework_element.GetAllFlags();
+  if (framework_element.IsPort())
   {
-    if (i < cMAX_LINKS)
+    core::tAbstractPort& port = static_cast<core::tAbstractPort&>(framework_element);
+    if (data_ports::IsDataFlowType(port.GetDataType()))
     {
-      std::string name = stream.ReadString();
-      links[i] = { name, stream.ReadBoolean() };
+      data_ports::common::tAbstractDataPort& data_port = static_cast<data_ports::common::tAbstractDataPort&>(port);
+      changeable_info.strategy = data_port.GetStrategy();
+      changeable_info.min_net_update_time = data_port.GetMinNetUpdateIntervalRaw();
     }
     else
     {
-      FINROC_LOG_PRINT(WARNING, "More than ", cMAX_LINKS, " received. Skipping additional ones.");
+      changeable_info.min_net_update_time = 0;  // dummy value - as in original format
     }
+    changeable_info.quality_of_service = tQualityOfService::Get(port);
   }
-
-  stream >> type >> changeable_info;
+  return changeable_info;
 }
 
 void tFrameworkElementInfo::Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
                                       tStructureExchange structure_exchange_level, std::string& string_buffer)
+{
+  tStructureEncodingState default_encoding;
+  Serialize(stream, framework_element, structure_exchange_level, string_buffer, default_encoding);
+}
+
+void tFrameworkElementInfo::Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
+                                      tStructureExchange structure_exchange_level, std::string& string_buffer, tStructureEncodingState& encoding_state)
 {
   if (structure_exchange_level == tStructureExchange::NONE)
   {
@@ -123,7 +162,24 @@ void tFrameworkElementInfo::Serialize(rrlib::serialization::tOutputStream& strea
     if (structure_exchange_level == tStructureExchange::SHARED_PORTS)
     {
       bool unique = framework_element.GetQualifiedLink(string_buffer, i);
-      stream << (string_buffer.c_str() + 1) << unique;  // omit first slash
+      const char* link = string_buffer.c_str() + 1;  // omit first slash
+      if (encoding_state.flags.Get(tStructureEncodingFlag::LINK_FRONT_CODING))
+      {
+        size_t link_length = string_buffer.length() - 1;
+        size_t prefix_length = 0;
+        size_t max_prefix_length = std::min(link_length, encoding_state.previous_link.length());
+        while (prefix_length < max_prefix_length && link[prefix_length] == encoding_state.previous_link[prefix_length])
+        {
+          prefix_length++;
+        }
+        WriteVarInt(stream, prefix_length);
+        stream << (link + prefix_length) << unique;
+        encoding_state.previous_link.assign(link, link_length);
+      }
+      else
+      {
+        stream << link << unique;
+      }
     }
     else
     {
@@ -135,9 +191,22 @@ void tFrameworkElementInfo::Serialize(rrlib::serialization::tOutputStream& strea
   }
 
   // send additional info - depending on whether we have a port
-  if (!framework_element.IsPort())
+  if (encoding_state.flags.Get(tStructureEncodingFlag::COMPACT_FLAGS))
   {
-    stream << framework_element.GetAllFlags().Raw(); // TODO: We could save 2 bytes - as not all flags are relevant (first + last 8 bits are sufficient for ordinary framework elements)
+    if (!framework_element.IsPort())
+    {
+      tChangeablePortInfo::SerializeFlags(stream, framework_element.GetAllFlags(), encoding_state.flags);
+    }
+    else
+    {
+      core::tAbstractPort& port = static_cast<core::tAbstractPort&>(framework_element);
+      stream << port.GetDataType();
+      GetChangeableInfo(port).Serialize(stream, encoding_state.flags);
+    }
+  }
+  else if (!framework_element.IsPort())
+  {
+    stream << framework_element.GetAllFlags().Raw(); // COMPACT_FLAGS encoding only sends first + last 8 bits for ordinary framework elements
   }
   else
   {
@@ -156,16 +225,68 @@ void tFrameworkElementInfo::Serialize(rrlib::serialization::tOutputStream& strea
       uint16_t unused = 0;
       stream << unused << unused;
     }
+    if (encoding_state.flags.Get(tStructureEncodingFlag::QOS_INFO))
+    {
+      tQualityOfService quality_of_service = tQualityOfService::Get(port);
+      stream << static_cast<uint8_t>(quality_of_service.priority) << quality_of_service.latency_budget;
+    }
   }
 
   if (structure_exchange_level == tStructureExchange::FINSTRUCT)
   {
-    SerializeFinstructOnlyInfo(stream, framework_element);
+    SerializeFinstructOnlyInfo(stream, framework_element, encoding_state);
   }
 }
 
 void tFrameworkElementInfo::SerializeConnections(rrlib::serialization::tOutputStream& stream, core::tAbstractPort& port)
 {
+  tStructureEncodingState default_encoding;
+  SerializeConnections(stream, port, default_encoding);
+}
+
+void tFrameworkElementInfo::SerializeConnections(rrlib::serialization::tOutputStream& stream, core::tAbstractPort& port, tStructureEncodingState& encoding_state)
+{
+  if (encoding_state.flags.Get(tStructureEncodingFlag::CONNECTION_LISTS))
+  {
+    // copy connections once - so that count and entries are consistent if connections change concurrently
+    std::vector<core::tAbstractPort*> connections;
+    for (auto it = port.OutgoingConnectionsBegin(); it != port.OutgoingConnectionsEnd(); ++it)
+    {
+      connections.push_back(&(*it));
+    }
+    WriteVarInt(stream, connections.size());
+    for (core::tAbstractPort * connection : connections)
+    {
+      stream.WriteInt(connection->GetHandle());
+    }
+    uint8_t finstructed_bits = 0;
+    for (size_t i = 0; i < connections.size(); i++)
+    {
+      if (port.IsEdgeFinstructed(*connections[i]))
+      {
+        finstructed_bits |= (1 << (i % 8));
+      }
+      if (i % 8 == 7)
+      {
+        stream.WriteByte(finstructed_bits);
+        finstructed_bits = 0;
+      }
+    }
+    if (connections.size() % 8)
+    {
+      stream.WriteByte(finstructed_bits);
+    }
+
+    network_transport::tNetworkConnections* network_connections = port.GetAnnotation<network_transport::tNetworkConnections>();
+    bool has_network_connections = network_connections && network_connections->Count();
+    stream.WriteBoolean(has_network_connections);
+    if (has_network_connections)
+    {
+      network_connections->Serialize(stream, encoding_state.flags.Get(tStructureEncodingFlag::BINARY_RUNTIME_IDS));
+    }
+    return;
+  }
+
   network_transport::tNetworkConnections* network_connections = port.GetAnnotation<network_transport::tNetworkConnections>();
   bool has_network_connections = network_connections && network_connections->Count();
   std::array<core::tAbstractPort*, 256> connections;
@@ -198,16 +319,22 @@ void tFrameworkElementInfo::SerializeConnections(rrlib::serialization::tOutputSt
   // Possibly serialize network connections
   if (has_network_connections)
   {
-    stream << (*network_connections);
+    network_connections->Serialize(stream, encoding_state.flags.Get(tStructureEncodingFlag::BINARY_RUNTIME_IDS));
   }
 }
 
 void tFrameworkElementInfo::SerializeFinstructOnlyInfo(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element)
+{
+  tStructureEncodingState default_encoding;
+  SerializeFinstructOnlyInfo(stream, framework_element, default_encoding);
+}
+
+void tFrameworkElementInfo::SerializeFinstructOnlyInfo(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element, tStructureEncodingState& encoding_state)
 {
   // serialize connections?
   if (framework_element.IsPort())
   {
-    SerializeConnections(stream, static_cast<core::tAbstractPort&>(framework_element));
+    SerializeConnections(stream, static_cast<core::tAbstractPort&>(framework_element), encoding_state);
   }
 
   // possibly send tags
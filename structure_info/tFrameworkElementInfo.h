@@ -45,6 +45,7 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/network_transport/structure_info/tChangeablePortInfo.h"
+#include "plugins/network_transport/structure_info/tStructureEncoding.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -127,6 +128,66 @@ struct tFrameworkElementInfo
    */
   void Deserialize(rrlib::serialization::tInputStream& stream);
 
+  /*!
+   * Deserializes info on single framework element with structure exchange
+   * level SHARED_PORTS - serialized using specified optional encodings.
+   *
+   * \param stream Binary stream to deserialize from
+   * \param encoding_state Optional encodings used on this stream (and associated state)
+   */
+  void Deserialize(rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state);
+
+  /*!
+   * Reads links of framework element info with structure exchange level SHARED_PORTS
+   * (shared by all variants of Deserialize() - which differ in how link names are stored)
+   *
+   * \param stream Binary stream to deserialize from
+   * \param encoding_state Optional encodings used on this stream (and associated state)
+   * \param read_name Function (size_t prefix_length) that reads remainder of link name from stream and returns it.
+   *                  With LINK_FRONT_CODING, it must prepend 'prefix_length' characters of encoding_state.previous_link
+   *                  and assign the complete name to encoding_state.previous_link (prefix_length is valid).
+   * \param store_link Function (size_t index, name, bool unique) that stores link (only called for the first cMAX_LINKS links)
+   * \return Number of links stored
+   */
+  template <typename TReadName, typename TStoreLink>
+  static uint8_t DeserializeLinks(rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state, TReadName read_name, TStoreLink store_link)
+  {
+    bool front_coding = encoding_state.flags.Get(tStructureEncodingFlag::LINK_FRONT_CODING);
+    uint8_t serialized_link_count = stream.ReadByte();
+    uint8_t link_count = 0;
+    for (int i = 0; i < serialized_link_count; i++)
+    {
+      size_t prefix_length = 0;
+      if (front_coding)
+      {
+        prefix_length = static_cast<size_t>(ReadVarInt(stream));
+        if (prefix_length > encoding_state.previous_link.length())
+        {
+          FINROC_LOG_PRINT_STATIC(WARNING, "Invalid front coded link (prefix length ", prefix_length, " exceeds length of previous link). Stream is corrupt.");
+          prefix_length = encoding_state.previous_link.length();
+        }
+      }
+      auto name = read_name(prefix_length);
+      bool unique = stream.ReadBoolean();
+      if (i < cMAX_LINKS)
+      {
+        store_link(static_cast<size_t>(i), name, unique);
+        link_count++;
+      }
+      else
+      {
+        FINROC_LOG_PRINT_STATIC(WARNING, "More than ", cMAX_LINKS, " received. Skipping additional ones.");
+      }
+    }
+    return link_count;
+  }
+
+  /*!
+   * \param framework_element Framework element to get changeable info of
+   * \return Current changeable info of framework element (only flags are set if it is no data port)
+   */
+  static tChangeablePortInfo GetChangeableInfo(core::tFrameworkElement& framework_element);
+
   /*!
    * Serializes info on single framework element to stream so that it can later
    * be deserialized in typically another runtime environment.
@@ -139,6 +200,19 @@ struct tFrameworkElementInfo
   static void Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
                         tStructureExchange structure_exchange_level, std::string& string_buffer);
 
+  /*!
+   * Serializes info on single framework element to stream - using specified optional encodings
+   * (that connection partner must support).
+   *
+   * \param stream Binary stream to serialize to
+   * \param framework_element Framework element to serialize info of
+   * \param structure_exchange_level Determines how much information is serialized
+   * \param string_buffer Temporary string buffer
+   * \param encoding_state Optional encodings to use on this stream (and associated state)
+   */
+  static void Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
+                        tStructureExchange structure_exchange_level, std::string& string_buffer, tStructureEncodingState& encoding_state);
+
   /*!
    * Serializes connections of specified port
    *
@@ -147,6 +221,20 @@ struct tFrameworkElementInfo
    */
   static void SerializeConnections(rrlib::serialization::tOutputStream& stream, core::tAbstractPort& port);
 
+  /*!
+   * Serializes connections of specified port - using specified optional encodings.
+   *
+   * With CONNECTION_LISTS encoding, the format is:
+   *   [variable length connection count n][n handles of connected ports][ceil(n / 8) bytes bitmap: is edge finstructed?]
+   *   [bool: has network connections][tNetworkConnections if there are network connections]
+   * There is no limit on the number of connections.
+   *
+   * \param stream Binary stream to serialize to
+   * \param port Port to serialize connections of
+   * \param encoding_state Optional encodings to use on this stream (and associated state)
+   */
+  static void SerializeConnections(rrlib::serialization::tOutputStream& stream, core::tAbstractPort& port, tStructureEncodingState& encoding_state);
+
   /*!
    * Serializes information that is send to "finstruct clients" in addition to the data all "structure clients" receive.
    *
@@ -163,6 +251,16 @@ struct tFrameworkElementInfo
    * \param port Port to serialize connections of
    */
   static void SerializeFinstructOnlyInfo(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element);
+
+  /*!
+   * Serializes information that is send to "finstruct clients" in addition to the data all "structure clients" receive
+   * - using specified optional encodings (see other overload for details).
+   *
+   * \param stream Binary stream to serialize to
+   * \param framework_element Framework element to serialize info of
+   * \param encoding_state Optional encodings to use on this stream (and associated state)
+   */
+  static void SerializeFinstructOnlyInfo(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element, tStructureEncodingState& encoding_state);
 };
 
 //inline rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tFrameworkElementInfo& info)
@@ -0,0 +1,293 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tParallelStructureSerializer.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tParallelStructureSerializer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "rrlib/thread/tLock.h"
+#include "core/tRuntimeEnvironment.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tParallelStructureSerializer::tParallelStructureSerializer(unsigned int thread_count, size_t min_elements_per_thread) :
+  thread_count(thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency())),
+  min_elements_per_thread(std::max<size_t>(1, min_elements_per_thread)),
+  buffers(),
+  filtered_elements(),
+  workers(),
+  worker_mutex(),
+  chunks_available(),
+  chunks_done(),
+  chunks(),
+  next_chunk(0),
+  pending_chunks(0),
+  worker_exception(),
+  stop_workers(false)
+{}
+
+tParallelStructureSerializer::~tParallelStructureSerializer()
+{
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex);
+    stop_workers = true;
+  }
+  chunks_available.notify_all();
+  for (std::thread & worker : workers)
+  {
+    worker.join();
+  }
+}
+
+void tParallelStructureSerializer::Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+    tStructureExchange structure_exchange_level, bool write_handles)
+{
+  tStructureEncodingState default_encoding;
+  Serialize(stream, framework_elements, structure_exchange_level, write_handles, default_encoding);
+}
+
+void tParallelStructureSerializer::Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+    tStructureExchange structure_exchange_level, bool write_handles, tStructureEncodingState& encoding_state)
+{
+  rrlib::thread::tLock structure_lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  size_t used_threads = std::min<size_t>(thread_count, std::max<size_t>(1, framework_elements.size() / min_elements_per_thread));
+  if (used_threads <= 1 || stream.GetTypeEncoding() == rrlib::serialization::tTypeEncoding::CUSTOM || (!AllReady(framework_elements)))
+  {
+    SerializeRange(stream, framework_elements, 0, framework_elements.size(), structure_exchange_level, write_handles, encoding_state);
+    return;
+  }
+
+  // Calling thread serializes first chunk directly to stream - worker threads serialize remaining chunks to buffers
+  bool front_coding = encoding_state.flags.Get(tStructureEncodingFlag::LINK_FRONT_CODING) && structure_exchange_level == tStructureExchange::SHARED_PORTS;
+  size_t chunk_size = (framework_elements.size() + used_threads - 1) / used_threads;
+  while (buffers.size() < used_threads - 1)
+  {
+    buffers.emplace_back();
+  }
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex);
+    while (workers.size() < used_threads - 1)
+    {
+      workers.emplace_back(&tParallelStructureSerializer::WorkerLoop, this);
+    }
+    chunks.clear();
+    for (size_t i = 1; i < used_threads; i++)
+    {
+      size_t begin = std::min(framework_elements.size(), i * chunk_size);
+      size_t end = std::min(framework_elements.size(), begin + chunk_size);
+      tChunk chunk = { &framework_elements, begin, end, structure_exchange_level, write_handles, stream.GetTypeEncoding(), encoding_state, &buffers[i - 1] };
+      if (front_coding)
+      {
+        GetLastLinkBefore(framework_elements, begin, chunk.encoding_state.previous_link);
+      }
+      chunks.push_back(chunk);
+    }
+    next_chunk = 0;
+    pending_chunks = chunks.size();
+    worker_exception = std::exception_ptr();
+  }
+  chunks_available.notify_all();
+
+  // Worker threads access buffers and element list: wait for them to complete - also if this thread fails
+  std::exception_ptr exception;
+  try
+  {
+    SerializeRange(stream, framework_elements, 0, std::min(framework_elements.size(), chunk_size), structure_exchange_level, write_handles, encoding_state);
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+  {
+    std::unique_lock<std::mutex> lock(worker_mutex);
+    chunks_done.wait(lock, [this]()
+    {
+      return pending_chunks == 0;
+    });
+    if (!exception)
+    {
+      exception = worker_exception;
+    }
+  }
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+
+  for (size_t i = 0; i + 1 < used_threads; i++)
+  {
+    stream.Write(buffers[i].GetBuffer(), 0, buffers[i].GetSize());
+  }
+
+  if (front_coding)
+  {
+    GetLastLinkBefore(framework_elements, framework_elements.size(), encoding_state.previous_link);
+  }
+}
+
+void tParallelStructureSerializer::Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+    tStructureExchange structure_exchange_level, bool write_handles, tStructureEncodingState& encoding_state, const tStructureFilter& filter)
+{
+  rrlib::thread::tLock structure_lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  if (filter.MatchesAll())
+  {
+    Serialize(stream, framework_elements, structure_exchange_level, write_handles, encoding_state);
+    return;
+  }
+  filter.Select(framework_elements, filtered_elements);
+  Serialize(stream, filtered_elements, structure_exchange_level, write_handles, encoding_state);
+}
+
+bool tParallelStructureSerializer::AllReady(const std::vector<core::tFrameworkElement*>& framework_elements)
+{
+  for (core::tFrameworkElement * element : framework_elements)
+  {
+    if (!element->IsReady())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool tParallelStructureSerializer::GetLastLinkBefore(const std::vector<core::tFrameworkElement*>& framework_elements, size_t index, std::string& result)
+{
+  std::string string_buffer;
+  for (size_t i = index; i > 0; i--)
+  {
+    core::tFrameworkElement& element = *framework_elements[i - 1];
+    int link_count = element.GetLinkCount();
+    if (link_count > 0)
+    {
+      element.GetQualifiedLink(string_buffer, link_count - 1);
+      result.assign(string_buffer, 1, std::string::npos);  // omit first slash - as tFrameworkElementInfo::Serialize does
+      return true;
+    }
+  }
+  return false;
+}
+
+void tParallelStructureSerializer::WorkerLoop()
+{
+  std::unique_lock<std::mutex> lock(worker_mutex);
+  while (true)
+  {
+    chunks_available.wait(lock, [this]()
+    {
+      return stop_workers || next_chunk < chunks.size();
+    });
+    if (stop_workers)
+    {
+      return;
+    }
+    tChunk chunk = chunks[next_chunk];
+    next_chunk++;
+    lock.unlock();
+
+    std::exception_ptr exception;
+    try
+    {
+      rrlib::serialization::tOutputStream stream(*chunk.buffer, chunk.type_encoding);
+      SerializeRange(stream, *chunk.framework_elements, chunk.begin, chunk.end, chunk.structure_exchange_level, chunk.write_handles, chunk.encoding_state);
+      stream.Close();
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+
+    lock.lock();
+    if (exception && (!worker_exception))
+    {
+      worker_exception = exception;
+    }
+    pending_chunks--;
+    if (pending_chunks == 0)
+    {
+      chunks_done.notify_all();
+    }
+  }
+}
+
+void tParallelStructureSerializer::SerializeRange(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+    size_t begin, size_t end, tStructureExchange structure_exchange_level, bool write_handles, tStructureEncodingState& encoding_state)
+{
+  std::string string_buffer;
+  for (size_t i = begin; i < end; i++)
+  {
+    core::tFrameworkElement& element = *framework_elements[i];
+    if (write_handles)
+    {
+      stream.WriteInt(element.GetHandle());
+    }
+    tFrameworkElementInfo::Serialize(stream, element, structure_exchange_level, string_buffer, encoding_state);
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
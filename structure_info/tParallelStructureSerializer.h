@@ -0,0 +1,243 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tParallelStructureSerializer.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tParallelStructureSerializer
+ *
+ * \b tParallelStructureSerializer
+ *
+ * Serializes info on many framework elements using multiple threads.
+ *
+ * The list of elements is split into contiguous chunks.
+ * Each worker thread serializes one chunk to its own buffer.
+ * The buffers are written to the target stream in order - so the resulting
+ * byte stream is identical to serializing all elements in a single thread.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tParallelStructureSerializer_h__
+#define __plugins__network_transport__structure_info__tParallelStructureSerializer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tFrameworkElementInfo.h"
+#include "plugins/network_transport/structure_info/tStructureFilter.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Multi-threaded structure serialization
+/*!
+ * Serializes info on many framework elements using multiple threads.
+ *
+ * The list of elements is split into contiguous chunks.
+ * Each worker thread serializes one chunk to its own buffer.
+ * The buffers are written to the target stream in order - so the resulting
+ * byte stream is identical to serializing all elements in a single thread.
+ *
+ * Worker threads and buffers are kept for subsequent calls - so an instance should be reused.
+ * Serialize() must not be called concurrently on the same instance.
+ */
+class tParallelStructureSerializer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param thread_count Maximum number of threads to use (including calling thread). 0 selects number of hardware threads.
+   * \param min_elements_per_thread Minimum number of elements each thread serializes (fewer threads are used for small structures)
+   */
+  tParallelStructureSerializer(unsigned int thread_count = 0, size_t min_elements_per_thread = 2000);
+
+  /*! Stops and joins worker threads */
+  ~tParallelStructureSerializer();
+
+  tParallelStructureSerializer(const tParallelStructureSerializer&) = delete;
+  tParallelStructureSerializer& operator=(const tParallelStructureSerializer&) = delete;
+
+  /*!
+   * Serializes info on all specified framework elements to stream.
+   * Equivalent to calling tFrameworkElementInfo::Serialize for every element in order
+   * (optionally preceded by the element's handle).
+   *
+   * The calling thread acquires the runtime's structure mutex and holds it for the whole call - so
+   * no element can be deleted or changed while worker threads serialize it (the caller may already hold it).
+   * Worker threads never acquire the structure mutex: they only serialize elements that are ready -
+   * as info on these is accessible without locking. If any element is not ready (not initialized yet),
+   * or if the stream uses tTypeEncoding::CUSTOM (its custom type encoder is bound to the stream and
+   * cannot be used for the workers' buffers), all elements are serialized by the calling thread.
+   * If serialization throws in any thread, all threads finish their chunks and the first exception is rethrown.
+   *
+   * \param stream Binary stream to serialize to
+   * \param framework_elements Framework elements to serialize info of
+   * \param structure_exchange_level Determines how much information is serialized
+   * \param write_handles Write handle of each element (as int) before its info?
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+                 tStructureExchange structure_exchange_level, bool write_handles);
+
+  /*!
+   * Serializes info on all specified framework elements to stream - using specified optional encodings.
+   * Equivalent to calling tFrameworkElementInfo::Serialize with encoding state for every element in order
+   * (see other overload for details).
+   *
+   * \param stream Binary stream to serialize to
+   * \param framework_elements Framework elements to serialize info of
+   * \param structure_exchange_level Determines how much information is serialized
+   * \param write_handles Write handle of each element (as int) before its info?
+   * \param encoding_state Optional encodings to use on this stream (and associated state)
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+                 tStructureExchange structure_exchange_level, bool write_handles, tStructureEncodingState& encoding_state);
+
+  /*!
+   * Serializes info on all specified framework elements that match the specified filter to stream
+   * (see other overloads for details). Used for clients with structure subscriptions.
+   *
+   * \param stream Binary stream to serialize to
+   * \param framework_elements Framework elements to serialize info of (if they match filter)
+   * \param structure_exchange_level Determines how much information is serialized
+   * \param write_handles Write handle of each element (as int) before its info?
+   * \param encoding_state Optional encodings to use on this stream (and associated state)
+   * \param filter Filter of client's structure subscription
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+                 tStructureExchange structure_exchange_level, bool write_handles, tStructureEncodingState& encoding_state, const tStructureFilter& filter);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Chunk of elements that is serialized by a worker thread */
+  struct tChunk
+  {
+    const std::vector<core::tFrameworkElement*>* framework_elements;
+    size_t begin, end;
+    tStructureExchange structure_exchange_level;
+    bool write_handles;
+    rrlib::serialization::tTypeEncoding type_encoding;
+    tStructureEncodingState encoding_state;
+    rrlib::serialization::tMemoryBuffer* buffer;
+  };
+
+  /*! Maximum number of threads to use */
+  unsigned int thread_count;
+
+  /*! Minimum number of elements each thread serializes */
+  size_t min_elements_per_thread;
+
+  /*! Buffers for worker threads */
+  std::vector<rrlib::serialization::tMemoryBuffer> buffers;
+
+  /*! Temporary storage for elements that match filter */
+  std::vector<core::tFrameworkElement*> filtered_elements;
+
+  /*! Worker threads (started on demand) */
+  std::vector<std::thread> workers;
+
+  /*! Mutex for chunk queue and the following variables */
+  std::mutex worker_mutex;
+
+  /*! Notified when chunks are available or workers are to be stopped */
+  std::condition_variable chunks_available;
+
+  /*! Notified when all chunks have been serialized */
+  std::condition_variable chunks_done;
+
+  /*! Chunks of current Serialize() call */
+  std::vector<tChunk> chunks;
+
+  /*! Index of next chunk to serialize */
+  size_t next_chunk;
+
+  /*! Number of chunks not completely serialized yet */
+  size_t pending_chunks;
+
+  /*! First exception thrown by a worker thread during current call */
+  std::exception_ptr worker_exception;
+
+  /*! Set to stop worker threads */
+  bool stop_workers;
+
+
+  /*!
+   * \return True if all specified elements are ready (so that worker threads can serialize them without acquiring the structure mutex)
+   */
+  static bool AllReady(const std::vector<core::tFrameworkElement*>& framework_elements);
+
+  /*!
+   * Serializes specified range of elements to stream
+   */
+  static void SerializeRange(rrlib::serialization::tOutputStream& stream, const std::vector<core::tFrameworkElement*>& framework_elements,
+                             size_t begin, size_t end, tStructureExchange structure_exchange_level, bool write_handles, tStructureEncodingState& encoding_state);
+
+  /*!
+   * Determines last link that is serialized for elements before specified index
+   * (state at this position for front coding)
+   *
+   * \return False if none of the elements has links
+   */
+  static bool GetLastLinkBefore(const std::vector<core::tFrameworkElement*>& framework_elements, size_t index, std::string& result);
+
+  /*! Main loop of worker threads */
+  void WorkerLoop();
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
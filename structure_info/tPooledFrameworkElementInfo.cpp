@@ -0,0 +1,119 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tPooledFrameworkElementInfo.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tPooledFrameworkElementInfo.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tPooledFrameworkElementInfo::tPooledFrameworkElementInfo() :
+  links(),
+  link_count(0),
+  handle(0),
+  type(),
+  changeable_info()
+{}
+
+void tPooledFrameworkElementInfo::Deserialize(rrlib::serialization::tInputStream& stream, tStringPool& string_pool, tStructureEncodingState& encoding_state)
+{
+  bool front_coding = encoding_state.flags.Get(tStructureEncodingFlag::LINK_FRONT_CODING);
+  link_count = tFrameworkElementInfo::DeserializeLinks(stream, encoding_state, [&](size_t prefix_length)
+  {
+    tStringPool::tOffset name = string_pool.ReadString(stream, encoding_state.previous_link.c_str(), prefix_length);
+    if (front_coding)
+    {
+      encoding_state.previous_link.assign(string_pool.Get(name));  // no allocation once capacity suffices
+    }
+    return name;
+  },
+  [this](size_t index, tStringPool::tOffset name, bool unique)
+  {
+    links[index] = { name, unique };
+  });
+
+  stream >> type;
+  changeable_info.Deserialize(stream, encoding_state.flags);
+}
+
+tFrameworkElementInfo tPooledFrameworkElementInfo::ToFrameworkElementInfo(const tStringPool& string_pool) const
+{
+  tFrameworkElementInfo result;
+  result.link_count = link_count;
+  for (size_t i = 0; i < link_count; i++)
+  {
+    result.links[i] = { GetLinkName(i, string_pool), links[i].unique };
+  }
+  result.handle = handle;
+  result.type = type;
+  result.changeable_info = changeable_info;
+  return result;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,147 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tPooledFrameworkElementInfo.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tPooledFrameworkElementInfo
+ *
+ * \b tPooledFrameworkElementInfo
+ *
+ * Variant of tFrameworkElementInfo that stores link names in a tStringPool.
+ * Deserializing info on a remote element into it does not allocate memory
+ * (once string pool and encoding state have grown to their working size).
+ * This is intended for receiving large remote structures.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tPooledFrameworkElementInfo_h__
+#define __plugins__network_transport__structure_info__tPooledFrameworkElementInfo_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tFrameworkElementInfo.h"
+#include "plugins/network_transport/structure_info/tStringPool.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Framework element information with link names in string pool
+/*!
+ * Information on shared ports - as exchanged by peers.
+ * Same content as tFrameworkElementInfo - but link names are stored in a
+ * tStringPool instead of std::strings. Therefore, deserializing does not
+ * allocate memory for every element.
+ */
+struct tPooledFrameworkElementInfo
+{
+  typedef tFrameworkElementInfo::tHandle tHandle;
+
+  /*!
+   * Infos regarding links to this element
+   */
+  struct tLinkInfo
+  {
+    /*! Offset of name in string pool */
+    tStringPool::tOffset name;
+
+    /*! Port with globally unique UID? */
+    bool unique;
+  };
+
+  /*! Information about links to this port - currently in fixed array for efficiency reasons */
+  std::array<tLinkInfo, tFrameworkElementInfo::cMAX_LINKS> links;
+
+  /*! Number of links */
+  uint8_t link_count;
+
+  /*! Handle in runtime environment */
+  tHandle handle;
+
+  /*! Type of port data */
+  rrlib::rtti::tType type;
+
+  /*! Inconstant port information */
+  tChangeablePortInfo changeable_info;
+
+
+  tPooledFrameworkElementInfo();
+
+  /*!
+   * Deserializes info on single framework element with structure exchange
+   * level SHARED_PORTS (see tFrameworkElementInfo::Deserialize).
+   * Link names are appended to the provided string pool.
+   *
+   * \param stream Binary stream to deserialize from
+   * \param string_pool String pool to store link names in
+   * \param encoding_state Optional encodings used on this stream (and associated state)
+   */
+  void Deserialize(rrlib::serialization::tInputStream& stream, tStringPool& string_pool, tStructureEncodingState& encoding_state);
+
+  /*!
+   * \param index Index of link
+   * \param string_pool String pool that link names were deserialized to
+   * \return Name of link with specified index
+   */
+  const char* GetLinkName(size_t index, const tStringPool& string_pool) const
+  {
+    return string_pool.Get(links[index].name);
+  }
+
+  /*!
+   * Copies info to (allocating) tFrameworkElementInfo
+   *
+   * \param string_pool String pool that link names were deserialized to
+   * \return Framework element info with same content
+   */
+  tFrameworkElementInfo ToFrameworkElementInfo(const tStringPool& string_pool) const;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -32,6 +32,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include "rrlib/thread/tLock.h"
 #include "core/tFrameworkElementTags.h"
 
 //----------------------------------------------------------------------
@@ -65,24 +66,197 @@ namespace structure_info
 // Const values
 //----------------------------------------------------------------------
 
+/*! Initial size of buffers for entries in change log */
+static const size_t cINITIAL_CHANGE_BUFFER_SIZE = 256;
+
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
 
 tRemoteRuntime::tRemoteRuntime(const std::string& protocol, tFrameworkElement* parent, const tString& name, tFlags flags) :
-  core::tFrameworkElement(parent, name, flags)
+  core::tFrameworkElement(parent, name, flags),
+  transport(tNetworkTransportPlugin::FindByProtocol(protocol)),
+  change_log_mutex(),
+  change_log_enabled(false),
+  full_structure(),
+  full_structure_version(0),
+  first_change_version(0),
+  changes()
 {
   core::tFrameworkElementTags::AddTag(*this, "remote_runtime: " + protocol);
 }
 
-void tRemoteRuntime::InitRemoteStructure(const rrlib::serialization::tFixedBuffer& current_structure_info)
+uint64_t tRemoteRuntime::GetStructureVersion() const
+{
+  rrlib::thread::tLock lock(change_log_mutex);
+  return first_change_version + changes.size();
+}
+
+void tRemoteRuntime::InitRemoteStructure(const rrlib::serialization::tFixedBuffer& current_structure_info, bool change_log)
 {
   rrlib::serialization::tMemoryBuffer buffer;
   rrlib::serialization::tOutputStream stream(buffer);
   stream.Write(current_structure_info);
   stream.Close();
-  structure_updates_port = data_ports::tOutputPort<rrlib::serialization::tMemoryBuffer>(this, "Structure", buffer);
+  InitRemoteStructure(std::move(buffer), change_log);
+}
+
+void tRemoteRuntime::InitRemoteStructure(rrlib::serialization::tMemoryBuffer && current_structure_info, bool change_log)
+{
+  structure_updates_port = data_ports::tOutputPort<rrlib::serialization::tMemoryBuffer>(this, "Structure");
+  if (change_log)
+  {
+    structure_updates_port.SetPullRequestHandler(this);
+    structure_changes_port = data_ports::tOutputPort<rrlib::serialization::tMemoryBuffer>(this, "Structure Changes");
+    {
+      rrlib::thread::tLock lock(change_log_mutex);
+      change_log_enabled = true;
+    }
+    UpdateRemoteStructure(std::move(current_structure_info), false);
+  }
   structure_updates_port.Init();
+  if (change_log)
+  {
+    structure_changes_port.Init();
+  }
+
+  // publish after initializing port (publishing to ports that are not ready has no effect)
+  rrlib::thread::tLock lock(change_log_mutex);
+  auto buffer = structure_updates_port.GetUnusedBuffer();
+  if (change_log)
+  {
+    rrlib::serialization::tOutputStream stream(*buffer);
+    SerializeFullStructureOnly(stream);
+    stream.Close();
+  }
+  else
+  {
+    (*buffer) = std::move(current_structure_info);
+  }
+  structure_updates_port.Publish(buffer);
+}
+
+data_ports::tPortDataPointer<const rrlib::serialization::tMemoryBuffer> tRemoteRuntime::OnPullRequest(data_ports::tOutputPort<rrlib::serialization::tMemoryBuffer>& origin)
+{
+  auto buffer = origin.GetUnusedBuffer();
+  rrlib::serialization::tOutputStream stream(*buffer);
+  SerializeFullStructure(stream);
+  stream.Close();
+  return std::move(buffer);
+}
+
+void tRemoteRuntime::PublishStructureChange(const rrlib::serialization::tFixedBuffer& change_info)
+{
+  rrlib::serialization::tMemoryBuffer buffer(cINITIAL_CHANGE_BUFFER_SIZE);
+  rrlib::serialization::tOutputStream stream(buffer);
+  stream.Write(change_info);
+  stream.Close();
+  PublishStructureChange(std::move(buffer));
+}
+
+void tRemoteRuntime::PublishStructureChange(rrlib::serialization::tMemoryBuffer && change_info)
+{
+  rrlib::thread::tLock lock(change_log_mutex);
+  if (!change_log_enabled)
+  {
+    FINROC_LOG_PRINT(ERROR, "Change log mode is not enabled. Ignoring change.");
+    return;
+  }
+
+  changes.emplace_back(std::move(change_info));
+
+  auto change_buffer = structure_changes_port.GetUnusedBuffer();
+  rrlib::serialization::tOutputStream stream(*change_buffer);
+  SerializeChangesFrom(changes.size() - 1, stream);
+  stream.Close();
+  structure_changes_port.Publish(change_buffer);
+}
+
+bool tRemoteRuntime::SerializeChanges(uint64_t since_version, rrlib::serialization::tOutputStream& stream) const
+{
+  rrlib::thread::tLock lock(change_log_mutex);
+  if ((!change_log_enabled) || since_version < first_change_version || since_version > first_change_version + changes.size())
+  {
+    return false;
+  }
+  SerializeChangesFrom(static_cast<size_t>(since_version - first_change_version), stream);
+  return true;
+}
+
+void tRemoteRuntime::SerializeChangesFrom(size_t first_change_index, rrlib::serialization::tOutputStream& stream) const
+{
+  stream << tStructureUpdateType::CHANGES;
+  stream.WriteLong(first_change_version + first_change_index);
+  stream.WriteLong(first_change_version + changes.size());
+  for (size_t i = first_change_index; i < changes.size(); i++)
+  {
+    const rrlib::serialization::tMemoryBuffer& change = changes[i];
+    stream.WriteInt(static_cast<int>(change.GetSize()));
+    stream.Write(change.GetBuffer(), 0, change.GetSize());
+  }
+}
+
+void tRemoteRuntime::SerializeFullStructure(rrlib::serialization::tOutputStream& stream) const
+{
+  rrlib::thread::tLock lock(change_log_mutex);
+  if (!change_log_enabled)
+  {
+    FINROC_LOG_PRINT(ERROR, "Change log mode is not enabled.");
+    return;
+  }
+  SerializeFullStructureWithChanges(stream);
+}
+
+void tRemoteRuntime::SerializeFullStructureOnly(rrlib::serialization::tOutputStream& stream) const
+{
+  stream << tStructureUpdateType::FULL_STRUCTURE;
+  stream.WriteLong(full_structure_version);
+  stream.Write(full_structure.GetBuffer(), 0, full_structure.GetSize());
+}
+
+void tRemoteRuntime::SerializeFullStructureWithChanges(rrlib::serialization::tOutputStream& stream) const
+{
+  SerializeFullStructureOnly(stream);
+  size_t first_index = static_cast<size_t>(full_structure_version - first_change_version);
+  if (first_index < changes.size())
+  {
+    SerializeChangesFrom(first_index, stream);
+  }
+}
+
+void tRemoteRuntime::UpdateRemoteStructure(const rrlib::serialization::tFixedBuffer& current_structure_info, bool publish)
+{
+  rrlib::serialization::tMemoryBuffer buffer;
+  rrlib::serialization::tOutputStream stream(buffer);
+  stream.Write(current_structure_info);
+  stream.Close();
+  UpdateRemoteStructure(std::move(buffer), publish);
+}
+
+void tRemoteRuntime::UpdateRemoteStructure(rrlib::serialization::tMemoryBuffer && current_structure_info, bool publish)
+{
+  rrlib::thread::tLock lock(change_log_mutex);
+  if (!change_log_enabled)
+  {
+    FINROC_LOG_PRINT(ERROR, "Change log mode is not enabled. Ignoring structure.");
+    return;
+  }
+
+  // retain changes since previous full structure
+  size_t obsolete_changes = static_cast<size_t>(full_structure_version - first_change_version);
+  changes.erase(changes.begin(), changes.begin() + obsolete_changes);
+  first_change_version = full_structure_version;
+  full_structure_version = first_change_version + changes.size();
+  full_structure = std::move(current_structure_info);
+
+  if (publish)
+  {
+    auto buffer = structure_updates_port.GetUnusedBuffer();
+    rrlib::serialization::tOutputStream stream(*buffer);
+    SerializeFullStructureOnly(stream);
+    stream.Close();
+    structure_updates_port.Publish(buffer);
+  }
 }
 
 //----------------------------------------------------------------------
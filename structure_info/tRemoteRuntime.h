@@ -33,6 +33,9 @@
  * (e.g. running on embedded hardware).
  * This class provides access for finstruct, manages structure information and tunnels requests.
  *
+ * Optionally, structure information is managed in a versioned change log.
+ * Then, changes are additionally published separately - so that subscribers that
+ * already hold a certain version of the structure only need to receive the changes.
  */
 //----------------------------------------------------------------------
 #ifndef __plugins__network_transport__structure_info__tRemoteRuntime_h__
@@ -41,11 +44,15 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <deque>
+#include "rrlib/thread/tMutex.h"
 #include "plugins/data_ports/tOutputPort.h"
+#include "plugins/data_ports/tPullRequestHandler.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkTransportPlugin.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -61,6 +68,19 @@ namespace structure_info
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
 
+/*!
+ * Types of messages published via tRemoteRuntime's structure ports in change log mode
+ *
+ * Message format:
+ *  FULL_STRUCTURE: [type][uint64 version][structure info]
+ *  CHANGES:        [type][uint64 from version][uint64 to version]([int size][change info])*
+ */
+enum class tStructureUpdateType : uint8_t
+{
+  FULL_STRUCTURE, //!< Complete structure of specified version
+  CHANGES         //!< Changes that transform structure from one version to another
+};
+
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
@@ -70,7 +90,7 @@ namespace structure_info
  * (e.g. running on embedded hardware).
  * This class provides access for finstruct, manages structure information and tunnels requests.
  */
-class tRemoteRuntime : public core::tFrameworkElement
+class tRemoteRuntime : public core::tFrameworkElement, public data_ports::tPullRequestHandler<rrlib::serialization::tMemoryBuffer>
 {
 
 //----------------------------------------------------------------------
@@ -82,9 +102,26 @@ public:
    * Port that publishes updates on remote runtime's structure.
    * On new connections, the whole structure is transferred
    * (this is done via the same port in order to synchronize on updates)
+   *
+   * In change log mode, messages are prefixed with a tStructureUpdateType header.
+   * A FULL_STRUCTURE message is only published when the full structure is replaced
+   * (InitRemoteStructure() and UpdateRemoteStructure() with 'publish' set) - changes are published via
+   * structure_changes_port only. Pull requests are answered with the current full structure - followed
+   * by a CHANGES message with all changes since then (see SerializeFullStructure()). Therefore, subscribers
+   * that connect later should pull the structure once and subscribe to structure_changes_port afterwards.
    */
   data_ports::tOutputPort<rrlib::serialization::tMemoryBuffer> structure_updates_port;
 
+  /*!
+   * Port that publishes every single change as CHANGES message (change log mode only).
+   * Subscribers obtain the structure with pull strategy from structure_updates_port once -
+   * and subscribe to this port to receive only the changes afterwards.
+   * Changes with a 'to version' that does not exceed the version a subscriber holds need to be ignored
+   * (e.g. the last change that is pushed on connection). If the 'from version' of a change exceeds
+   * the version a subscriber holds, it missed changes and needs to pull structure_updates_port again.
+   */
+  data_ports::tOutputPort<rrlib::serialization::tMemoryBuffer> structure_changes_port;
+
 
   /*!
    * \param protocol Id of protocol used to access this node
@@ -96,16 +133,125 @@ public:
    * Creates structure update port - which will initially serve the structure passed to this function.
    *
    * \param current_structure_info Structure information that will be served initially
+   * \param change_log Manage structure information in versioned change log? (see class description)
+   */
+  void InitRemoteStructure(const rrlib::serialization::tFixedBuffer& current_structure_info, bool change_log = false);
+
+  /*!
+   * Creates structure update port - which will initially serve the structure passed to this function.
+   *
+   * Takes ownership of the buffer's memory: it is moved to the port's buffer (or the full structure
+   * in change log mode) without copying the structure information.
+   *
+   * \param current_structure_info Structure information that will be served initially (empty after call)
+   * \param change_log Manage structure information in versioned change log? (see class description)
+   */
+  void InitRemoteStructure(rrlib::serialization::tMemoryBuffer && current_structure_info, bool change_log = false);
+
+  /*!
+   * \return Current version of structure information (only meaningful in change log mode; 0 after InitRemoteStructure)
+   */
+  uint64_t GetStructureVersion() const;
+
+  /*!
+   * \return Network transport plugin that registered this remote runtime's protocol ID (resolved once on construction) - nullptr if there is none
    */
-  void InitRemoteStructure(const rrlib::serialization::tFixedBuffer& current_structure_info);
+  tNetworkTransportPlugin* GetTransport() const
+  {
+    return tNetworkTransportPlugin::Get(transport);
+  }
+
+  /*!
+   * Publishes change of remote structure via structure_changes_port (change log mode only).
+   * Increments structure version. structure_updates_port is not republished - so only the change is transferred.
+   *
+   * \param change_info Information on changes (opaque - e.g. serialized framework element info)
+   */
+  void PublishStructureChange(const rrlib::serialization::tFixedBuffer& change_info);
+
+  /*!
+   * Publishes change of remote structure (change log mode only) - taking ownership of the buffer's memory:
+   * it is moved to the change log without copying (see other overload for details).
+   *
+   * \param change_info Information on changes (empty after call)
+   */
+  void PublishStructureChange(rrlib::serialization::tMemoryBuffer && change_info);
+
+  /*!
+   * Serializes all changes since specified version as CHANGES message (change log mode only)
+   *
+   * \param since_version Version of structure that subscriber holds
+   * \param stream Stream to serialize changes to
+   * \return False if changes since this version are no longer (or not yet) available - then nothing is written to stream. Full structure needs to be transferred in this case.
+   */
+  bool SerializeChanges(uint64_t since_version, rrlib::serialization::tOutputStream& stream) const;
+
+  /*!
+   * Serializes latest full structure (FULL_STRUCTURE message) - followed by CHANGES message
+   * with all changes since this full structure (if there are any) - (change log mode only)
+   *
+   * \param stream Stream to serialize structure to
+   */
+  void SerializeFullStructure(rrlib::serialization::tOutputStream& stream) const;
+
+  /*!
+   * Replaces full structure with current one (change log mode only) - keeps version number.
+   * Changes since the previous full structure are retained, so that subscribers holding any version
+   * since then can still obtain the changes via SerializeChanges(). Older changes are removed.
+   * Should be called regularly, as change log would grow indefinitely otherwise.
+   *
+   * \param current_structure_info Current structure information
+   * \param publish Publish full structure via structure_updates_port?
+   */
+  void UpdateRemoteStructure(const rrlib::serialization::tFixedBuffer& current_structure_info, bool publish = false);
+
+  /*!
+   * Replaces full structure with current one (change log mode only) - taking ownership of the buffer's memory
+   * (see other overload for details).
+   *
+   * \param current_structure_info Current structure information (empty after call)
+   * \param publish Publish full structure via structure_updates_port?
+   */
+  void UpdateRemoteStructure(rrlib::serialization::tMemoryBuffer && current_structure_info, bool publish = false);
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  /*! Answers pull requests on structure_updates_port with current structure (change log mode only) */
+  virtual data_ports::tPortDataPointer<const rrlib::serialization::tMemoryBuffer> OnPullRequest(data_ports::tOutputPort<rrlib::serialization::tMemoryBuffer>& origin) override;
+
+  /*! Handle of network transport plugin that registered protocol ID */
+  const tNetworkTransportPlugin::tPluginHandle transport;
+
+  /*! Mutex for change log */
+  mutable rrlib::thread::tMutex change_log_mutex;
+
+  /*! Is structure information managed in change log? */
+  bool change_log_enabled;
+
+  /*! Latest full structure (change log mode only) */
+  rrlib::serialization::tMemoryBuffer full_structure;
+
+  /*! Version of 'full_structure' */
+  uint64_t full_structure_version;
+
+  /*! Version that first entry in 'changes' transforms (<= full_structure_version) */
+  uint64_t first_change_version;
+
+  /*! Retained changes (change i transforms version first_change_version + i to first_change_version + i + 1) */
+  std::deque<rrlib::serialization::tMemoryBuffer> changes;
+
+
+  /*! Serializes changes in 'changes' - starting with specified index - as CHANGES message */
+  void SerializeChangesFrom(size_t first_change_index, rrlib::serialization::tOutputStream& stream) const;
 
+  /*! Serializes 'full_structure' as FULL_STRUCTURE message */
+  void SerializeFullStructureOnly(rrlib::serialization::tOutputStream& stream) const;
 
+  /*! Serializes 'full_structure' and all changes since then (unlocked variant of SerializeFullStructure()) */
+  void SerializeFullStructureWithChanges(rrlib::serialization::tOutputStream& stream) const;
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,350 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tRemoteStructureTable.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tRemoteStructureTable.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tStructureChangeBatch.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Minimum number of orphaned link entries and string pool bytes before link columns are compacted (avoids frequent compaction of small tables) */
+static const size_t cMIN_LINKS_TO_COMPACT = 1024;
+static const size_t cMIN_STRING_BYTES_TO_COMPACT = 16 * 1024;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tRemoteStructureTable::tRemoteStructureTable() :
+  handles(),
+  types(),
+  flags(),
+  strategies(),
+  min_net_update_times(),
+  qualities_of_service(),
+  first_links(),
+  link_counts(),
+  link_names(),
+  link_unique(),
+  string_pool(),
+  index(),
+  temp_info(),
+  orphaned_links(0),
+  orphaned_string_bytes(0)
+{}
+
+void tRemoteStructureTable::Clear()
+{
+  handles.clear();
+  types.clear();
+  flags.clear();
+  strategies.clear();
+  min_net_update_times.clear();
+  qualities_of_service.clear();
+  first_links.clear();
+  link_counts.clear();
+  link_names.clear();
+  link_unique.clear();
+  string_pool.Clear();
+  index.clear();
+  orphaned_links = 0;
+  orphaned_string_bytes = 0;
+}
+
+void tRemoteStructureTable::CompactLinks()
+{
+  std::vector<tStringPool::tOffset> new_link_names;
+  std::vector<bool> new_link_unique;
+  tStringPool new_string_pool(string_pool.Size() - orphaned_string_bytes);
+  new_link_names.reserve(link_names.size() - orphaned_links);
+  new_link_unique.reserve(link_names.size() - orphaned_links);
+  for (size_t i = 0; i < handles.size(); i++)
+  {
+    uint32_t first_link = first_links[i];
+    first_links[i] = static_cast<uint32_t>(new_link_names.size());
+    for (size_t j = 0; j < link_counts[i]; j++)
+    {
+      const char* name = string_pool.Get(link_names[first_link + j]);
+      new_link_names.push_back(new_string_pool.Add(name, strlen(name)));
+      new_link_unique.push_back(link_unique[first_link + j]);
+    }
+  }
+  link_names.swap(new_link_names);
+  link_unique.swap(new_link_unique);
+  std::swap(string_pool, new_string_pool);
+  orphaned_links = 0;
+  orphaned_string_bytes = 0;
+}
+
+void tRemoteStructureTable::CompactLinksIfNecessary()
+{
+  if ((orphaned_links >= cMIN_LINKS_TO_COMPACT && orphaned_links * 2 > link_names.size()) ||
+      (orphaned_string_bytes >= cMIN_STRING_BYTES_TO_COMPACT && orphaned_string_bytes * 2 > string_pool.Size()))
+  {
+    CompactLinks();
+  }
+}
+
+size_t tRemoteStructureTable::DeserializeChangeBatch(rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state)
+{
+  size_t change_count = tStructureChangeBatch::ReadChangeCount(stream);
+  tChangeablePortInfo changeable_info;
+  for (size_t i = 0; i < change_count; i++)
+  {
+    tStructureChangeType change_type;
+    tHandle handle;
+    if (!tStructureChangeBatch::ReadChange(stream, change_type, handle))
+    {
+      FINROC_LOG_PRINT(WARNING, "Invalid structure change type ", static_cast<int>(change_type), ". Stream is corrupt.");
+      return i;
+    }
+    switch (change_type)
+    {
+    case tStructureChangeType::ADD:
+      DeserializeElement(handle, stream, encoding_state);
+      break;
+    case tStructureChangeType::CHANGE:
+      changeable_info.Deserialize(stream, encoding_state.flags);
+      UpdateChangeableInfo(handle, changeable_info);
+      break;
+    case tStructureChangeType::REMOVE:
+      Remove(handle);
+      break;
+    }
+  }
+  return change_count;
+}
+
+size_t tRemoteStructureTable::DeserializeElement(tHandle handle, rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state)
+{
+  temp_info.Deserialize(stream, string_pool, encoding_state);
+
+  size_t element_index = Find(handle);
+  if (element_index == cNOT_FOUND)
+  {
+    element_index = handles.size();
+    index.emplace(handle, element_index);
+    handles.push_back(handle);
+    types.push_back(temp_info.type);
+    flags.push_back(temp_info.changeable_info.flags);
+    strategies.push_back(temp_info.changeable_info.strategy);
+    min_net_update_times.push_back(temp_info.changeable_info.min_net_update_time);
+    qualities_of_service.push_back(temp_info.changeable_info.quality_of_service);
+    first_links.push_back(0);
+    link_counts.push_back(0);
+  }
+  else
+  {
+    types[element_index] = temp_info.type;
+    flags[element_index] = temp_info.changeable_info.flags;
+    strategies[element_index] = temp_info.changeable_info.strategy;
+    min_net_update_times[element_index] = temp_info.changeable_info.min_net_update_time;
+    qualities_of_service[element_index] = temp_info.changeable_info.quality_of_service;
+
+    // reuse slots in link columns if new links fit
+    bool reuse_slots = temp_info.link_count <= link_counts[element_index];
+    ReleaseLinks(element_index, !reuse_slots);
+    if (reuse_slots)
+    {
+      orphaned_links += link_counts[element_index] - temp_info.link_count;
+      link_counts[element_index] = temp_info.link_count;
+      for (size_t i = 0; i < temp_info.link_count; i++)
+      {
+        link_names[first_links[element_index] + i] = temp_info.links[i].name;
+        link_unique[first_links[element_index] + i] = temp_info.links[i].unique;
+      }
+      CompactLinksIfNecessary();
+      return element_index;
+    }
+  }
+
+  first_links[element_index] = static_cast<uint32_t>(link_names.size());
+  link_counts[element_index] = temp_info.link_count;
+  for (size_t i = 0; i < temp_info.link_count; i++)
+  {
+    link_names.push_back(temp_info.links[i].name);
+    link_unique.push_back(temp_info.links[i].unique);
+  }
+  CompactLinksIfNecessary();
+  return element_index;
+}
+
+size_t tRemoteStructureTable::DeserializeElements(rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state)
+{
+  size_t count = 0;
+  while (stream.MoreDataAvailable())
+  {
+    tHandle handle = stream.ReadInt();
+    DeserializeElement(handle, stream, encoding_state);
+    count++;
+  }
+  return count;
+}
+
+tChangeablePortInfo tRemoteStructureTable::GetChangeableInfo(size_t index) const
+{
+  tChangeablePortInfo result;
+  result.flags = flags[index];
+  result.strategy = strategies[index];
+  result.min_net_update_time = min_net_update_times[index];
+  result.quality_of_service = qualities_of_service[index];
+  return result;
+}
+
+void tRemoteStructureTable::GetPortsOfType(const rrlib::rtti::tType& type, std::vector<tHandle>& result) const
+{
+  for (size_t i = 0; i < types.size(); i++)
+  {
+    if (types[i] == type)
+    {
+      result.push_back(handles[i]);
+    }
+  }
+}
+
+void tRemoteStructureTable::ReleaseLinks(size_t element_index, bool release_slots)
+{
+  for (size_t i = 0; i < link_counts[element_index]; i++)
+  {
+    orphaned_string_bytes += strlen(string_pool.Get(link_names[first_links[element_index] + i])) + 1;
+  }
+  if (release_slots)
+  {
+    orphaned_links += link_counts[element_index];
+  }
+}
+
+bool tRemoteStructureTable::Remove(tHandle handle)
+{
+  auto it = index.find(handle);
+  if (it == index.end())
+  {
+    return false;
+  }
+  size_t element_index = it->second;
+  index.erase(it);
+  ReleaseLinks(element_index, true);
+
+  size_t last = handles.size() - 1;
+  if (element_index != last)
+  {
+    handles[element_index] = handles[last];
+    types[element_index] = types[last];
+    flags[element_index] = flags[last];
+    strategies[element_index] = strategies[last];
+    min_net_update_times[element_index] = min_net_update_times[last];
+    qualities_of_service[element_index] = qualities_of_service[last];
+    first_links[element_index] = first_links[last];
+    link_counts[element_index] = link_counts[last];
+    index[handles[element_index]] = element_index;
+  }
+  handles.pop_back();
+  types.pop_back();
+  flags.pop_back();
+  strategies.pop_back();
+  min_net_update_times.pop_back();
+  qualities_of_service.pop_back();
+  first_links.pop_back();
+  link_counts.pop_back();
+  CompactLinksIfNecessary();
+  return true;
+}
+
+void tRemoteStructureTable::Reserve(size_t element_count, size_t string_pool_bytes)
+{
+  handles.reserve(element_count);
+  types.reserve(element_count);
+  flags.reserve(element_count);
+  strategies.reserve(element_count);
+  min_net_update_times.reserve(element_count);
+  qualities_of_service.reserve(element_count);
+  first_links.reserve(element_count);
+  link_counts.reserve(element_count);
+  link_names.reserve(element_count);
+  link_unique.reserve(element_count);
+  index.reserve(element_count);
+  if (string_pool_bytes)
+  {
+    string_pool.Reserve(string_pool_bytes);
+  }
+}
+
+bool tRemoteStructureTable::UpdateChangeableInfo(tHandle handle, const tChangeablePortInfo& changeable_info)
+{
+  size_t element_index = Find(handle);
+  if (element_index == cNOT_FOUND)
+  {
+    return false;
+  }
+  flags[element_index] = changeable_info.flags;
+  strategies[element_index] = changeable_info.strategy;
+  min_net_update_times[element_index] = changeable_info.min_net_update_time;
+  qualities_of_service[element_index] = changeable_info.quality_of_service;
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
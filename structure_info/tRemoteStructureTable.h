@@ -0,0 +1,310 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tRemoteStructureTable.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tRemoteStructureTable
+ *
+ * \b tRemoteStructureTable
+ *
+ * Columnar (structure-of-arrays) storage for info on the shared ports of a
+ * remote runtime environment. Link names are stored in a shared string pool.
+ * Compared to a vector of tFrameworkElementInfo objects, this requires
+ * significantly less memory per mirrored element and makes scans over single
+ * attributes (e.g. all ports of a certain type) cache-friendly.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tRemoteStructureTable_h__
+#define __plugins__network_transport__structure_info__tRemoteStructureTable_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <unordered_map>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tPooledFrameworkElementInfo.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Columnar table with info on remote shared ports
+/*!
+ * Stores info on the shared ports of a remote runtime environment in
+ * separate arrays per attribute. Elements are addressed by index
+ * (0 to Count() - 1) - and can be looked up by handle in O(1).
+ *
+ * Removing elements changes the index of the last element (it is moved to the
+ * free slot). Link entries and names of removed or replaced elements remain in the
+ * link columns and string pool until they make up more than half of them -
+ * then the link columns and the string pool are compacted.
+ */
+class tRemoteStructureTable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef tFrameworkElementInfo::tHandle tHandle;
+  typedef tFrameworkElementInfo::tFlags tFlags;
+
+  /*! Index returned by Find() if there is no element with specified handle */
+  enum : size_t { cNOT_FOUND = static_cast<size_t>(-1) };
+
+  tRemoteStructureTable();
+
+  /*!
+   * Removes all elements from table (keeps capacity)
+   */
+  void Clear();
+
+  /*!
+   * \return Number of elements in table
+   */
+  size_t Count() const
+  {
+    return handles.size();
+  }
+
+  /*!
+   * Applies batch of structure changes (see tStructureChangeBatch - as serialized by
+   * tStructureChangeBatcher with structure exchange level SHARED_PORTS) to table.
+   *
+   * \param stream Binary stream to deserialize from
+   * \param encoding_state Optional encodings used on this stream (and associated state)
+   * \return Number of changes in batch
+   */
+  size_t DeserializeChangeBatch(rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state);
+
+  /*!
+   * Deserializes info on single shared port (structure exchange level SHARED_PORTS) and adds it to table.
+   * If there already is an element with the specified handle, it is replaced.
+   *
+   * \param handle Handle of element
+   * \param stream Binary stream to deserialize from
+   * \param encoding_state Optional encodings used on this stream (and associated state)
+   * \return Index of element in table
+   */
+  size_t DeserializeElement(tHandle handle, rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state);
+
+  /*!
+   * Bulk decoder: Deserializes handles and infos on shared ports (as written by
+   * tParallelStructureSerializer with write_handles set) until the end of the stream is reached.
+   *
+   * \param stream Binary stream to deserialize from
+   * \param encoding_state Optional encodings used on this stream (and associated state)
+   * \return Number of elements that were deserialized
+   */
+  size_t DeserializeElements(rrlib::serialization::tInputStream& stream, tStructureEncodingState& encoding_state);
+
+  /*!
+   * \param handle Handle of element
+   * \return Index of element with specified handle - or cNOT_FOUND if there is no such element
+   */
+  size_t Find(tHandle handle) const
+  {
+    auto it = index.find(handle);
+    return it == index.end() ? cNOT_FOUND : it->second;
+  }
+
+  /*!
+   * \param index Index of element
+   * \return Changeable info of element with specified index
+   */
+  tChangeablePortInfo GetChangeableInfo(size_t index) const;
+
+  /*!
+   * Column accessors (element with index i is at position i in every column)
+   */
+  const std::vector<tFlags>& GetFlags() const
+  {
+    return flags;
+  }
+  const std::vector<tHandle>& GetHandles() const
+  {
+    return handles;
+  }
+  const std::vector<int16_t>& GetMinNetUpdateTimes() const
+  {
+    return min_net_update_times;
+  }
+  const std::vector<tQualityOfService>& GetQualitiesOfService() const
+  {
+    return qualities_of_service;
+  }
+  const std::vector<int16_t>& GetStrategies() const
+  {
+    return strategies;
+  }
+  const std::vector<rrlib::rtti::tType>& GetTypes() const
+  {
+    return types;
+  }
+
+  /*!
+   * \param index Index of element
+   * \return Number of links of element with specified index
+   */
+  size_t GetLinkCount(size_t index) const
+  {
+    return link_counts[index];
+  }
+
+  /*!
+   * \param index Index of element
+   * \param link_index Index of link
+   * \return Name of link (pointer is valid until next element is added)
+   */
+  const char* GetLinkName(size_t index, size_t link_index) const
+  {
+    return string_pool.Get(link_names[first_links[index] + link_index]);
+  }
+
+  /*!
+   * Appends handles of all ports with specified data type to result vector
+   *
+   * \param type Data type
+   * \param result Vector to append handles to
+   */
+  void GetPortsOfType(const rrlib::rtti::tType& type, std::vector<tHandle>& result) const;
+
+  /*!
+   * \param index Index of element
+   * \param link_index Index of link
+   * \return Port with globally unique UID?
+   */
+  bool IsLinkUnique(size_t index, size_t link_index) const
+  {
+    return link_unique[first_links[index] + link_index];
+  }
+
+  /*!
+   * Removes element from table
+   *
+   * \param handle Handle of element to remove
+   * \return True if element was found and removed
+   */
+  bool Remove(tHandle handle);
+
+  /*!
+   * Reserves memory for specified number of elements
+   *
+   * \param element_count Number of elements
+   * \param string_pool_bytes Number of bytes to reserve for link names
+   */
+  void Reserve(size_t element_count, size_t string_pool_bytes = 0);
+
+  /*!
+   * Updates changeable info of element
+   *
+   * \param handle Handle of element
+   * \param changeable_info New changeable info
+   * \return True if element was found and updated
+   */
+  bool UpdateChangeableInfo(tHandle handle, const tChangeablePortInfo& changeable_info);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Element columns */
+  std::vector<tHandle> handles;
+  std::vector<rrlib::rtti::tType> types;
+  std::vector<tFlags> flags;
+  std::vector<int16_t> strategies;
+  std::vector<int16_t> min_net_update_times;
+  std::vector<tQualityOfService> qualities_of_service;
+  std::vector<uint32_t> first_links;
+  std::vector<uint8_t> link_counts;
+
+  /*! Link columns (links of an element are stored consecutively - starting at first_links[index]) */
+  std::vector<tStringPool::tOffset> link_names;
+  std::vector<bool> link_unique;
+
+  /*! String pool containing link names */
+  tStringPool string_pool;
+
+  /*! Handle => index of element */
+  std::unordered_map<tHandle, size_t> index;
+
+  /*! Temporary info object used for deserialization */
+  tPooledFrameworkElementInfo temp_info;
+
+  /*! Number of entries in link columns that no element refers to anymore */
+  size_t orphaned_links;
+
+  /*! Number of bytes in string pool that no link refers to anymore */
+  size_t orphaned_string_bytes;
+
+
+  /*!
+   * Rebuilds link columns and string pool without orphaned entries
+   * (this changes first_links of all elements)
+   */
+  void CompactLinks();
+
+  /*!
+   * Marks links of specified element as orphaned
+   * (called before they are replaced or removed)
+   *
+   * \param element_index Index of element
+   * \param release_slots Mark entries in link columns as orphaned? (otherwise only link names in string pool)
+   */
+  void ReleaseLinks(size_t element_index, bool release_slots);
+
+  /*!
+   * Compacts links if orphaned entries make up more than half of link columns or string pool
+   */
+  void CompactLinksIfNecessary();
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
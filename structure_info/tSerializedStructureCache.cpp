@@ -0,0 +1,153 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tSerializedStructureCache.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tSerializedStructureCache.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "rrlib/thread/tLock.h"
+#include "core/tRuntimeEnvironment.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tSerializedStructureCache::tSerializedStructureCache() :
+  mutex(),
+  entries(),
+  temp_buffer()
+{
+  core::tRuntimeEnvironment::GetInstance().AddListener(*this);
+}
+
+tSerializedStructureCache::~tSerializedStructureCache()
+{
+  core::tRuntimeEnvironment::GetInstance().RemoveListener(*this);
+}
+
+void tSerializedStructureCache::Clear()
+{
+  rrlib::thread::tLock lock(mutex);
+  entries.clear();
+}
+
+void tSerializedStructureCache::OnEdgeChange(tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target)
+{
+  // connections are not cached
+}
+
+void tSerializedStructureCache::OnFrameworkElementChange(tEvent change_type, core::tFrameworkElement& element)
+{
+  rrlib::thread::tLock lock(mutex);
+  entries.erase(element.GetHandle());
+}
+
+void tSerializedStructureCache::Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
+    tStructureExchange structure_exchange_level, std::string& string_buffer)
+{
+  tStructureEncodingState default_encoding;
+  Serialize(stream, framework_element, structure_exchange_level, string_buffer, default_encoding);
+}
+
+void tSerializedStructureCache::Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
+    tStructureExchange structure_exchange_level, std::string& string_buffer, tStructureEncodingState& encoding_state)
+{
+  rrlib::serialization::tTypeEncoding type_encoding = stream.GetTypeEncoding();
+  bool front_coded = structure_exchange_level == tStructureExchange::SHARED_PORTS && encoding_state.flags.Get(tStructureEncodingFlag::LINK_FRONT_CODING);
+  if (structure_exchange_level == tStructureExchange::NONE || front_coded || type_encoding == rrlib::serialization::tTypeEncoding::CUSTOM)
+  {
+    tFrameworkElementInfo::Serialize(stream, framework_element, structure_exchange_level, string_buffer, encoding_state);
+    return;
+  }
+
+  // FINSTRUCT info is COMPLETE_STRUCTURE info followed by finstruct-only info (see tFrameworkElementInfo::SerializeFinstructOnlyInfo)
+  tStructureExchange cached_level = structure_exchange_level == tStructureExchange::SHARED_PORTS ? tStructureExchange::SHARED_PORTS : tStructureExchange::COMPLETE_STRUCTURE;
+  {
+    rrlib::thread::tLock lock(mutex);
+    tEntry& entry = entries[framework_element.GetHandle()];
+    auto cached = std::find_if(entry.begin(), entry.end(), [&](const tSerializedInfo & info)
+    {
+      return info.structure_exchange_level == cached_level && info.type_encoding == type_encoding && info.encoding_flags.Raw() == encoding_state.flags.Raw();
+    });
+    if (cached == entry.end())
+    {
+      rrlib::serialization::tOutputStream temp_stream(temp_buffer, type_encoding);
+      tFrameworkElementInfo::Serialize(temp_stream, framework_element, cached_level, string_buffer, encoding_state);
+      temp_stream.Close();
+      entry.push_back({ cached_level, type_encoding, encoding_state.flags, std::vector<char>(temp_buffer.GetBuffer().GetPointer(), temp_buffer.GetBuffer().GetPointer() + temp_buffer.GetSize()) });
+      cached = entry.end() - 1;
+    }
+    stream.Write(rrlib::serialization::tFixedBuffer(cached->data.data(), cached->data.size()));
+  }
+
+  if (structure_exchange_level == tStructureExchange::FINSTRUCT)
+  {
+    tFrameworkElementInfo::SerializeFinstructOnlyInfo(stream, framework_element, encoding_state);
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,179 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tSerializedStructureCache.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tSerializedStructureCache
+ *
+ * \b tSerializedStructureCache
+ *
+ * Cache for serialized framework element info.
+ *
+ * Stores the bytes that tFrameworkElementInfo::Serialize writes for each element
+ * and structure exchange level. When multiple clients connect to a runtime environment,
+ * serializing its structure is then mostly copying cached fragments.
+ * Entries are invalidated whenever the runtime environment reports changes to an element.
+ *
+ * Port connections (part of tStructureExchange::FINSTRUCT info) are not cached,
+ * as they change frequently - they are serialized on each call.
+ * Cached data is stored per type encoding and set of optional structure encodings.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tSerializedStructureCache_h__
+#define __plugins__network_transport__structure_info__tSerializedStructureCache_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <unordered_map>
+#include "rrlib/thread/tMutex.h"
+#include "core/tRuntimeListener.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tFrameworkElementInfo.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Cache for serialized framework element info
+/*!
+ * Stores the bytes that tFrameworkElementInfo::Serialize writes for each element
+ * and structure exchange level. Entries are invalidated whenever the runtime environment
+ * reports changes to an element.
+ *
+ * Port connections (part of tStructureExchange::FINSTRUCT info) are not cached.
+ * Cached data is stored per type encoding and set of optional structure encodings.
+ * Info that depends on the previously serialized element (front coded links) and
+ * streams with custom type encoding are not cached.
+ */
+class tSerializedStructureCache : public core::tRuntimeListener
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Creates cache and registers it as listener at runtime environment
+   */
+  tSerializedStructureCache();
+
+  ~tSerializedStructureCache();
+
+  /*!
+   * Removes all entries from cache
+   */
+  void Clear();
+
+  /*!
+   * Serializes info on single framework element to stream - using cached data if available.
+   * Equivalent to tFrameworkElementInfo::Serialize (see there).
+   *
+   * \param stream Binary stream to serialize to
+   * \param framework_element Framework element to serialize info of
+   * \param structure_exchange_level Determines how much information is serialized
+   * \param string_buffer Temporary string buffer
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
+                 tStructureExchange structure_exchange_level, std::string& string_buffer);
+
+  /*!
+   * Serializes info on single framework element to stream - using specified optional encodings and cached data if available.
+   * Equivalent to tFrameworkElementInfo::Serialize (see there).
+   *
+   * \param stream Binary stream to serialize to
+   * \param framework_element Framework element to serialize info of
+   * \param structure_exchange_level Determines how much information is serialized
+   * \param string_buffer Temporary string buffer
+   * \param encoding_state Optional encodings to use on this stream (and associated state)
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, core::tFrameworkElement& framework_element,
+                 tStructureExchange structure_exchange_level, std::string& string_buffer, tStructureEncodingState& encoding_state);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Serialized info for one structure exchange level and encoding */
+  struct tSerializedInfo
+  {
+    /*! Structure exchange level (SHARED_PORTS or COMPLETE_STRUCTURE) */
+    tStructureExchange structure_exchange_level;
+
+    /*! Type encoding of stream */
+    rrlib::serialization::tTypeEncoding type_encoding;
+
+    /*! Optional structure encodings */
+    tStructureEncodingFlags encoding_flags;
+
+    /*! Serialized info */
+    std::vector<char> data;
+  };
+
+  /*! Cached data for single framework element (typically only very few variants are used) */
+  typedef std::vector<tSerializedInfo> tEntry;
+
+  /*! Mutex for cache entries */
+  rrlib::thread::tMutex mutex;
+
+  /*! Cached data by element handle */
+  std::unordered_map<core::tFrameworkElement::tHandle, tEntry> entries;
+
+  /*! Temporary buffer for serializing elements that are not cached yet */
+  rrlib::serialization::tMemoryBuffer temp_buffer;
+
+
+  virtual void OnEdgeChange(tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target) override;
+
+  virtual void OnFrameworkElementChange(tEvent change_type, core::tFrameworkElement& element) override;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
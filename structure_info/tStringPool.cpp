@@ -0,0 +1,133 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStringPool.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tStringPool.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Number of bytes pool grows by while reading a string (if it has no spare capacity) */
+static const size_t cREAD_BLOCK_SIZE = 256;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tStringPool::tStringPool(size_t initial_capacity) :
+  data()
+{
+  data.reserve(initial_capacity);
+}
+
+tStringPool::tOffset tStringPool::Add(const char* string, size_t length)
+{
+  tOffset offset = static_cast<tOffset>(data.size());
+  data.insert(data.end(), string, string + length);
+  data.push_back(0);
+  return offset;
+}
+
+tStringPool::tOffset tStringPool::ReadString(rrlib::serialization::tInputStream& stream, const char* prefix, size_t prefix_length)
+{
+  tOffset offset = static_cast<tOffset>(data.size());
+  size_t position = data.size() + prefix_length;
+  data.resize(position + cREAD_BLOCK_SIZE);
+  if (prefix_length)
+  {
+    memcpy(&data[offset], prefix, prefix_length);
+  }
+
+  // read characters directly into pool memory - growing it block-wise (instead of appending each character)
+  try
+  {
+    while (true)
+    {
+      char* write_position = &data[position];
+      char* block_end = data.data() + data.size();
+      while (write_position != block_end)
+      {
+        char c = static_cast<char>(stream.ReadByte());
+        *write_position = c;
+        write_position++;
+        if (c == 0)
+        {
+          data.resize(write_position - data.data());
+          return offset;
+        }
+      }
+      position = data.size();
+      data.resize(data.size() + cREAD_BLOCK_SIZE);
+    }
+  }
+  catch (...)
+  {
+    data.resize(offset);
+    throw;
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
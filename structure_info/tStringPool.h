@@ -0,0 +1,161 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStringPool.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tStringPool
+ *
+ * \b tStringPool
+ *
+ * Stores many strings (e.g. links of remote framework elements) in a single
+ * contiguous buffer. Strings are referenced by their offset in this buffer.
+ * Adding strings does not allocate memory - unless the buffer needs to grow.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tStringPool_h__
+#define __plugins__network_transport__structure_info__tStringPool_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Pool for strings
+/*!
+ * Stores many strings in a single contiguous buffer (null-terminated).
+ * Strings are referenced by their offset in this buffer - as pointers
+ * become invalid when the buffer grows.
+ * Adding strings does not allocate memory - unless the buffer needs to grow.
+ */
+class tStringPool
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Offset of string in pool */
+  typedef uint32_t tOffset;
+
+  /*!
+   * \param initial_capacity Initial capacity of buffer in bytes
+   */
+  tStringPool(size_t initial_capacity = 64 * 1024);
+
+  /*!
+   * Adds string to pool
+   *
+   * \param string String to add
+   * \param length Length of string
+   * \return Offset of string in pool
+   */
+  tOffset Add(const char* string, size_t length);
+
+  /*!
+   * Removes all strings from pool (keeps capacity)
+   */
+  void Clear()
+  {
+    data.clear();
+  }
+
+  /*!
+   * \param offset Offset of string in pool
+   * \return String at specified offset (pointer is valid until next string is added)
+   */
+  const char* Get(tOffset offset) const
+  {
+    return &data[offset];
+  }
+
+  /*!
+   * Reads null-terminated string (as written by rrlib serialization) from stream to pool.
+   * Characters are written directly to pool memory (which grows block-wise).
+   * If reading fails, the pool is left unchanged.
+   *
+   * \param stream Stream to read string from
+   * \param prefix Prefix to prepend to string that is read (optional)
+   * \param prefix_length Length of prefix
+   * \return Offset of string in pool
+   */
+  tOffset ReadString(rrlib::serialization::tInputStream& stream, const char* prefix = nullptr, size_t prefix_length = 0);
+
+  /*!
+   * Reserves memory for specified number of bytes
+   */
+  void Reserve(size_t capacity)
+  {
+    data.reserve(capacity);
+  }
+
+  /*!
+   * \return Number of bytes used by strings in pool (including terminating null characters)
+   */
+  size_t Size() const
+  {
+    return data.size();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Buffer containing all strings */
+  std::vector<char> data;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
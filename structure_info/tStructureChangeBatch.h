@@ -0,0 +1,147 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStructureChangeBatch.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tStructureChangeBatch
+ *
+ * \b tStructureChangeBatch
+ *
+ * Wire format of batches of structure changes - as written by
+ * tStructureChangeBatcher and read by tRemoteStructureTable.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tStructureChangeBatch_h__
+#define __plugins__network_transport__structure_info__tStructureChangeBatch_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
+#include "core/tFrameworkElement.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*! Types of structure changes in a batch */
+enum class tStructureChangeType : uint8_t
+{
+  ADD,     //!< Framework element was added (or initialized)
+  CHANGE,  //!< Changeable info (or connections) of framework element changed
+  REMOVE   //!< Framework element was removed
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Wire format of structure change batches
+/*!
+ * Format of a serialized batch:
+ *   [int: number of changes n] n * [byte: tStructureChangeType][int: handle][change data]
+ * Change data is
+ *   ADD:    tFrameworkElementInfo (as serialized by tFrameworkElementInfo::Serialize)
+ *   CHANGE: tChangeablePortInfo - followed by port connections for tStructureExchange::FINSTRUCT and ports
+ *           (as serialized by tFrameworkElementInfo::SerializeConnections)
+ *   REMOVE: nothing
+ *
+ * This class writes and reads everything except of the change data.
+ */
+struct tStructureChangeBatch
+{
+  typedef core::tFrameworkElement::tHandle tHandle;
+
+  /*!
+   * Reads header of single change
+   *
+   * \param stream Binary stream to deserialize from
+   * \param change_type Is set to type of change
+   * \param handle Is set to handle of changed element
+   * \return False if change type is invalid (stream is corrupt then)
+   */
+  static bool ReadChange(rrlib::serialization::tInputStream& stream, tStructureChangeType& change_type, tHandle& handle)
+  {
+    uint8_t type = static_cast<uint8_t>(stream.ReadByte());
+    handle = stream.ReadInt();
+    change_type = static_cast<tStructureChangeType>(type);
+    return type <= static_cast<uint8_t>(tStructureChangeType::REMOVE);
+  }
+
+  /*!
+   * \param stream Binary stream to deserialize from
+   * \return Number of changes in batch
+   */
+  static size_t ReadChangeCount(rrlib::serialization::tInputStream& stream)
+  {
+    int change_count = stream.ReadInt();
+    return change_count > 0 ? static_cast<size_t>(change_count) : 0;
+  }
+
+  /*!
+   * Writes header of single change (change data needs to follow)
+   *
+   * \param stream Binary stream to serialize to
+   * \param change_type Type of change
+   * \param handle Handle of changed element
+   */
+  static void WriteChange(rrlib::serialization::tOutputStream& stream, tStructureChangeType change_type, tHandle handle)
+  {
+    stream.WriteByte(static_cast<uint8_t>(change_type));
+    stream.WriteInt(handle);
+  }
+
+  /*!
+   * \param stream Binary stream to serialize to
+   * \param change_count Number of changes in batch
+   */
+  static void WriteChangeCount(rrlib::serialization::tOutputStream& stream, size_t change_count)
+  {
+    stream.WriteInt(static_cast<int>(change_count));
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
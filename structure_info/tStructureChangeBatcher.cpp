@@ -0,0 +1,313 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStructureChangeBatcher.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tStructureChangeBatcher.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "core/tRuntimeEnvironment.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+typedef core::tFrameworkElement::tFlag tFlag;
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tStructureChangeBatcher::tStructureChangeBatcher(tStructureExchange structure_exchange_level, const tParameters& parameters, const tStructureFilter& filter) :
+  structure_exchange_level(structure_exchange_level),
+  parameters(parameters),
+  mutex(),
+  filter(filter),
+  pending_changes(),
+  order(),
+  next_sequence(0),
+  first_change_time(),
+  client_elements()
+{
+  core::tRuntimeEnvironment::GetInstance().AddListener(*this);
+}
+
+tStructureChangeBatcher::~tStructureChangeBatcher()
+{
+  core::tRuntimeEnvironment::GetInstance().RemoveListener(*this);
+}
+
+void tStructureChangeBatcher::AddPendingChange(tChangeType change_type, core::tFrameworkElement& element)
+{
+  tHandle handle = element.GetHandle();
+  if (order.empty())
+  {
+    first_change_time = std::chrono::steady_clock::now();
+  }
+
+  auto it = pending_changes.find(handle);
+  if (it == pending_changes.end())
+  {
+    tPendingChange change = { change_type, false, change_type == tChangeType::REMOVE ? nullptr : &element, next_sequence++ };
+    pending_changes.emplace(handle, change);
+    order.emplace(change.sequence, handle);
+    return;
+  }
+
+  tPendingChange& change = it->second;
+  switch (change_type)
+  {
+  case tChangeType::ADD:
+    // (Handle was possibly reused) Move to current position - so that element is added after its (possibly new) parent
+    change.removed_before |= (change.type == tChangeType::REMOVE);
+    change.type = tChangeType::ADD;
+    change.element = &element;
+    order.erase(change.sequence);
+    change.sequence = next_sequence++;
+    order.emplace(change.sequence, handle);
+    break;
+  case tChangeType::CHANGE:
+    // Pending ADD or CHANGE already contains element's current info
+    break;
+  case tChangeType::REMOVE:
+    if (change.type == tChangeType::ADD && (!change.removed_before))
+    {
+      // Client never knew element
+      order.erase(change.sequence);
+      pending_changes.erase(it);
+      return;
+    }
+    change.type = tChangeType::REMOVE;
+    change.removed_before = false;
+    change.element = nullptr;
+    break;
+  }
+}
+
+void tStructureChangeBatcher::Clear()
+{
+  rrlib::thread::tLock lock(mutex);
+  pending_changes.clear();
+  order.clear();
+  client_elements.clear();
+}
+
+tStructureFilter tStructureChangeBatcher::GetFilter() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return filter;
+}
+
+tStructureChangeBatcher::tTimestamp tStructureChangeBatcher::GetFlushTime() const
+{
+  rrlib::thread::tLock lock(mutex);
+  if (order.empty())
+  {
+    return tTimestamp::max();
+  }
+  return order.size() >= parameters.max_changes ? first_change_time : first_change_time + parameters.window;
+}
+
+size_t tStructureChangeBatcher::GetPendingChangeCount() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return order.size();
+}
+
+bool tStructureChangeBatcher::IsBatchReady(tTimestamp now) const
+{
+  return GetFlushTime() <= now;
+}
+
+bool tStructureChangeBatcher::IsRelevant(core::tFrameworkElement& element) const
+{
+  if (structure_exchange_level == tStructureExchange::NONE)
+  {
+    return false;
+  }
+  return structure_exchange_level != tStructureExchange::SHARED_PORTS || (element.IsPort() && element.GetFlag(tFlag::SHARED));
+}
+
+void tStructureChangeBatcher::OnEdgeChange(tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target)
+{
+  if (structure_exchange_level == tStructureExchange::FINSTRUCT)
+  {
+    RecordChange(tEvent::CHANGE, source);
+  }
+}
+
+void tStructureChangeBatcher::OnFrameworkElementChange(tEvent change_type, core::tFrameworkElement& element)
+{
+  if (change_type == tEvent::PRE_INIT || structure_exchange_level == tStructureExchange::NONE)
+  {
+    return;
+  }
+  RecordChange(change_type, element);
+}
+
+void tStructureChangeBatcher::RecordChange(tEvent change_type, core::tFrameworkElement& element)
+{
+  rrlib::thread::tLock lock(mutex);
+  tHandle handle = element.GetHandle();
+  bool known = client_elements.find(handle) != client_elements.end();
+  bool matches = change_type != tEvent::REMOVE && IsRelevant(element) && filter.Matches(element);
+  if (matches)
+  {
+    // Elements that client has no info on yet (e.g. because they just entered filter) are added
+    AddPendingChange((known && change_type == tEvent::CHANGE) ? tChangeType::CHANGE : tChangeType::ADD, element);
+    client_elements.insert(handle);
+  }
+  else if (known)
+  {
+    // Element was removed or left filter
+    AddPendingChange(tChangeType::REMOVE, element);
+    client_elements.erase(handle);
+  }
+}
+
+size_t tStructureChangeBatcher::SerializeBatch(rrlib::serialization::tOutputStream& stream, std::string& string_buffer, tStructureEncodingState& encoding_state)
+{
+  rrlib::thread::tLock lock1(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+  rrlib::thread::tLock lock2(mutex);
+
+  size_t change_count = order.size();
+  for (auto & entry : pending_changes)
+  {
+    change_count += entry.second.removed_before ? 1 : 0;
+  }
+  tStructureChangeBatch::WriteChangeCount(stream, change_count);
+
+  for (auto & entry : order)
+  {
+    const tPendingChange& change = pending_changes[entry.second];
+    if (change.removed_before)
+    {
+      tStructureChangeBatch::WriteChange(stream, tChangeType::REMOVE, entry.second);
+    }
+    tStructureChangeBatch::WriteChange(stream, change.type, entry.second);
+    if (change.type == tChangeType::ADD)
+    {
+      tFrameworkElementInfo::Serialize(stream, *change.element, structure_exchange_level, string_buffer, encoding_state);
+    }
+    else if (change.type == tChangeType::CHANGE)
+    {
+      tFrameworkElementInfo::GetChangeableInfo(*change.element).Serialize(stream, encoding_state.flags);
+      if (structure_exchange_level == tStructureExchange::FINSTRUCT && change.element->IsPort())
+      {
+        tFrameworkElementInfo::SerializeConnections(stream, static_cast<core::tAbstractPort&>(*change.element), encoding_state);
+      }
+    }
+  }
+
+  pending_changes.clear();
+  order.clear();
+  return change_count;
+}
+
+void tStructureChangeBatcher::SetClientElements(const std::vector<core::tFrameworkElement*>& elements)
+{
+  rrlib::thread::tLock lock(mutex);
+  pending_changes.clear();
+  order.clear();
+  client_elements.clear();
+  for (core::tFrameworkElement * element : elements)
+  {
+    if (IsRelevant(*element) && filter.Matches(*element))
+    {
+      client_elements.insert(element->GetHandle());
+    }
+  }
+}
+
+void tStructureChangeBatcher::SetFilter(const tStructureFilter& new_filter)
+{
+  core::tRuntimeEnvironment& runtime = core::tRuntimeEnvironment::GetInstance();
+  rrlib::thread::tLock lock1(runtime.GetStructureMutex());
+  rrlib::thread::tLock lock2(mutex);
+  filter = new_filter;
+  if (structure_exchange_level == tStructureExchange::NONE)
+  {
+    return;
+  }
+
+  // Elements the client has info on are ready elements - so iterating over these covers all of them
+  for (auto it = runtime.SubElementsBegin(true); it != runtime.SubElementsEnd(); ++it)
+  {
+    core::tFrameworkElement& element = *it;
+    if (!element.IsReady())
+    {
+      continue;
+    }
+    tHandle handle = element.GetHandle();
+    if (IsRelevant(element) && filter.Matches(element))
+    {
+      if (client_elements.insert(handle).second)
+      {
+        AddPendingChange(tChangeType::ADD, element);
+      }
+    }
+    else if (client_elements.erase(handle))
+    {
+      AddPendingChange(tChangeType::REMOVE, element);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,293 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStructureChangeBatcher.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tStructureChangeBatcher
+ *
+ * \b tStructureChangeBatcher
+ *
+ * Collects changes to the structure of the local runtime environment
+ * for a single structure client - so that they can be sent as one message.
+ *
+ * When a runtime environment starts (or a large group is created or deleted),
+ * every framework element change would otherwise result in its own message.
+ * The batcher merges redundant changes while they are pending:
+ *  - an element that is added and removed again is not sent at all
+ *  - repeated changes of an element result in a single change
+ *    (with the element's info at the time the batch is serialized)
+ *  - an element that is added is sent with its current info (later changes are included)
+ *
+ * A batch is ready when the configured time window has passed since its first
+ * change - or when it contains the configured maximum number of changes.
+ * Clients with a structure subscription (see tStructureFilter) only receive changes
+ * of elements that match their filter. Elements that start matching the filter
+ * (e.g. because a tag or flag was added) are sent as ADD - and elements that no
+ * longer match are sent as REMOVE.
+ * Changes are serialized in the order they first occurred (elements that were
+ * removed and added again are moved to the position of the latest add) - so
+ * parents are always added before their children.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tStructureChangeBatcher_h__
+#define __plugins__network_transport__structure_info__tStructureChangeBatcher_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include "rrlib/thread/tMutex.h"
+#include "core/tRuntimeListener.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tFrameworkElementInfo.h"
+#include "plugins/network_transport/structure_info/tStructureChangeBatch.h"
+#include "plugins/network_transport/structure_info/tStructureFilter.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Batches structure changes for a structure client
+/*!
+ * Collects and merges changes to the structure of the local runtime environment
+ * for a single structure client - so that they can be sent as one message
+ * (see tStructureChangeBatch for format).
+ * The network transport that serves the client checks IsBatchReady() regularly and sends the batch.
+ */
+class tStructureChangeBatcher : public core::tRuntimeListener
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef core::tFrameworkElement::tHandle tHandle;
+  typedef std::chrono::steady_clock::time_point tTimestamp;
+
+  typedef tStructureChangeType tChangeType;
+
+  /*! Configuration of batcher */
+  struct tParameters
+  {
+    /*! Time window after first change that changes are collected in */
+    std::chrono::milliseconds window;
+
+    /*! Maximum number of pending changes - batch is ready immediately when this number is reached */
+    size_t max_changes;
+
+    tParameters() :
+      window(50),
+      max_changes(10000)
+    {}
+  };
+
+  /*!
+   * Creates batcher and registers it as listener at runtime environment
+   *
+   * \param structure_exchange_level Structure exchange level of client (determines which changes are collected and how much information is serialized)
+   * \param parameters Configuration of batcher
+   * \param filter Filter of client's structure subscription (only changes of matching elements are collected)
+   */
+  tStructureChangeBatcher(tStructureExchange structure_exchange_level, const tParameters& parameters = tParameters(), const tStructureFilter& filter = tStructureFilter());
+
+  ~tStructureChangeBatcher();
+
+  /*!
+   * Discards all pending changes and forgets which elements the client has info on
+   * (e.g. because client is sent complete structure instead - see SetClientElements())
+   */
+  void Clear();
+
+  /*!
+   * \return Filter of client's structure subscription
+   */
+  tStructureFilter GetFilter() const;
+
+  /*!
+   * \return Time at which current batch will be ready (tTimestamp::max() if there are no pending changes)
+   */
+  tTimestamp GetFlushTime() const;
+
+  /*!
+   * \return Number of pending changes (after merging)
+   */
+  size_t GetPendingChangeCount() const;
+
+  /*!
+   * \return Structure exchange level of client
+   */
+  tStructureExchange GetStructureExchangeLevel() const
+  {
+    return structure_exchange_level;
+  }
+
+  /*!
+   * \param now Current time
+   * \return Whether there are pending changes and the time window has passed (or the maximum number of changes is reached)
+   */
+  bool IsBatchReady(tTimestamp now = std::chrono::steady_clock::now()) const;
+
+  /*!
+   * Serializes all pending changes as one batch (see tStructureChangeBatch for format) and clears them.
+   * Acquires the runtime's structure mutex - so this must not be called from runtime listener callbacks.
+   *
+   * \param stream Binary stream to serialize to
+   * \param string_buffer Temporary string buffer
+   * \param encoding_state Optional encodings to use on this stream (and associated state)
+   * \return Number of changes serialized
+   */
+  size_t SerializeBatch(rrlib::serialization::tOutputStream& stream, std::string& string_buffer, tStructureEncodingState& encoding_state);
+
+  /*!
+   * Discards all pending changes and sets the elements that client has info on
+   * (to be called when client is sent complete structure).
+   * Elements that are not relevant for client or do not match filter are ignored - so
+   * e.g. all elements of the runtime environment can be passed.
+   * Changes of elements the client has info on are sent as CHANGE or REMOVE - and changes of
+   * other elements that match the filter as ADD.
+   * If this is not called, the client is assumed to have info on no element initially.
+   * Must be called with the runtime's structure mutex held.
+   *
+   * \param elements Elements that client was sent info on
+   */
+  void SetClientElements(const std::vector<core::tFrameworkElement*>& elements);
+
+  /*!
+   * Changes filter of client's structure subscription.
+   * Elements the client has no info on that match the new filter are queued as ADD - and
+   * elements the client has info on that no longer match are queued as REMOVE.
+   * Acquires the runtime's structure mutex - so this must not be called from runtime listener callbacks.
+   *
+   * \param filter New filter
+   */
+  void SetFilter(const tStructureFilter& filter);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Pending change of single framework element */
+  struct tPendingChange
+  {
+    /*! Type of change to send */
+    tChangeType type;
+
+    /*! Element was removed before it was added again (REMOVE is sent before ADD) */
+    bool removed_before;
+
+    /*! Changed element (nullptr if type is REMOVE) */
+    core::tFrameworkElement* element;
+
+    /*! Position in batch */
+    uint64_t sequence;
+  };
+
+  /*! Structure exchange level of client */
+  const tStructureExchange structure_exchange_level;
+
+  /*! Configuration of batcher */
+  const tParameters parameters;
+
+  /*! Mutex for pending changes and filter */
+  mutable rrlib::thread::tMutex mutex;
+
+  /*! Filter of client's structure subscription */
+  tStructureFilter filter;
+
+  /*! Pending changes by element handle */
+  std::unordered_map<tHandle, tPendingChange> pending_changes;
+
+  /*! Handles of elements with pending changes - in the order they are serialized */
+  std::map<uint64_t, tHandle> order;
+
+  /*! Sequence number of next change */
+  uint64_t next_sequence;
+
+  /*! Time of first pending change */
+  tTimestamp first_change_time;
+
+  /*! Handles of elements that client has info on - once pending changes have been sent */
+  std::unordered_set<tHandle> client_elements;
+
+
+  /*!
+   * \param element Framework element
+   * \return Whether changes of element are relevant for client
+   */
+  bool IsRelevant(core::tFrameworkElement& element) const;
+
+  virtual void OnEdgeChange(tEvent change_type, core::tAbstractPort& source, core::tAbstractPort& target) override;
+
+  virtual void OnFrameworkElementChange(tEvent change_type, core::tFrameworkElement& element) override;
+
+  /*!
+   * Merges change of framework element with pending change
+   * (caller must hold mutex)
+   *
+   * \param change_type Type of change to send to client
+   * \param element Changed framework element
+   */
+  void AddPendingChange(tChangeType change_type, core::tFrameworkElement& element);
+
+  /*!
+   * Records change of framework element - if client has info on it or element matches filter
+   * (elements that enter or leave filter are recorded as ADD or REMOVE)
+   *
+   * \param change_type Type of change in runtime environment
+   * \param element Changed framework element
+   */
+  void RecordChange(tEvent change_type, core::tFrameworkElement& element);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,165 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStructureEncoding.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tStructureEncodingState
+ *
+ * \b tStructureEncodingState
+ *
+ * Optional encodings for structure exchange that both peers of a connection
+ * need to support - and state that is required for serializing or
+ * deserializing structure info with these encodings.
+ *
+ * The default state (no flags set) produces the original format that is understood
+ * by all peers.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tStructureEncoding_h__
+#define __plugins__network_transport__structure_info__tStructureEncoding_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tEnumBasedFlags.h"
+#include "rrlib/serialization/serialization.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*!
+ * Optional encodings for structure exchange
+ * (may only be used if both peers of a connection support them)
+ */
+enum class tStructureEncodingFlag
+{
+  LINK_FRONT_CODING,  //!< Links of shared ports are front coded: length of prefix shared with previous link is sent - followed by the remaining characters
+  COMPACT_FLAGS,      //!< Element flags are sent as variable length integers; strategy and network update interval are omitted if they have default values (see tChangeablePortInfo)
+  CONNECTION_LISTS,   //!< Port connections are sent with variable length count (no limit on number of connections) and a bitmap of finstructed flags (see tFrameworkElementInfo::SerializeConnections)
+  BINARY_RUNTIME_IDS, //!< UUIDs of runtime environments in network connections are sent as 16 byte tRuntimeId (tDestinationEncoding::BINARY_UUID_AND_HANDLE)
+  QOS_INFO            //!< Priority class and latency budget of ports are sent with changeable port info (see tChangeablePortInfo)
+};
+
+/*! Set of optional encodings for structure exchange */
+typedef rrlib::util::tEnumBasedFlags<tStructureEncodingFlag> tStructureEncodingFlags;
+
+constexpr inline tStructureEncodingFlags operator | (tStructureEncodingFlag flag1, tStructureEncodingFlag flag2)
+{
+  return tStructureEncodingFlags(flag1) | flag2;
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Encoding state for structure exchange
+/*!
+ * Optional encodings used for structure exchange on a connection -
+ * together with state required for serializing or deserializing structure
+ * info with these encodings.
+ *
+ * Each connection needs one instance per direction.
+ * Structure info must be deserialized in the order it was serialized.
+ */
+struct tStructureEncodingState
+{
+  /*! Optional encodings used */
+  tStructureEncodingFlags flags;
+
+  /*! Last link serialized or deserialized (for LINK_FRONT_CODING) */
+  std::string previous_link;
+
+
+  tStructureEncodingState(tStructureEncodingFlags flags = tStructureEncodingFlags()) :
+    flags(flags),
+    previous_link()
+  {}
+
+  /*!
+   * Resets state (e.g. when a new structure transfer starts)
+   */
+  void Reset()
+  {
+    previous_link.clear();
+  }
+};
+
+/*!
+ * Writes unsigned integer with variable length encoding (7 bits per byte, least significant bits first)
+ *
+ * \param stream Stream to write to
+ * \param value Value to write
+ */
+inline void WriteVarInt(rrlib::serialization::tOutputStream& stream, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    stream.WriteByte(static_cast<int8_t>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  stream.WriteByte(static_cast<int8_t>(value));
+}
+
+/*!
+ * Reads unsigned integer with variable length encoding (see WriteVarInt)
+ *
+ * \param stream Stream to read from
+ * \return Value that was read
+ */
+inline uint64_t ReadVarInt(rrlib::serialization::tInputStream& stream)
+{
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    uint8_t byte = static_cast<uint8_t>(stream.ReadByte());
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      break;
+    }
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
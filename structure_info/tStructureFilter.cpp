@@ -0,0 +1,168 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStructureFilter.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tStructureFilter.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+#include "core/tFrameworkElementTags.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tStructureEncoding.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+bool tStructureFilter::Matches(const core::tFrameworkElement& element) const
+{
+  uint32_t flags = element.GetAllFlags().Raw();
+  if ((flags & required_flags.Raw()) != required_flags.Raw() || (flags & excluded_flags.Raw()))
+  {
+    return false;
+  }
+  if (type && ((!element.IsPort()) || static_cast<const core::tAbstractPort&>(element).GetDataType() != type))
+  {
+    return false;
+  }
+  if (tag.length() && (!core::tFrameworkElementTags::IsTagged(element, tag)))
+  {
+    return false;
+  }
+  if (roots.empty())
+  {
+    return true;
+  }
+  for (const core::tFrameworkElement* current = &element; current; current = current->GetParent())
+  {
+    if (std::find(roots.begin(), roots.end(), current->GetHandle()) != roots.end())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void tStructureFilter::Select(const std::vector<core::tFrameworkElement*>& elements, std::vector<core::tFrameworkElement*>& result) const
+{
+  result.clear();
+  if (MatchesAll())
+  {
+    result = elements;
+    return;
+  }
+  for (core::tFrameworkElement * element : elements)
+  {
+    if (Matches(*element))
+    {
+      result.push_back(element);
+    }
+  }
+}
+
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tStructureFilter& filter)
+{
+  WriteVarInt(stream, filter.roots.size());
+  for (tStructureFilter::tHandle root : filter.roots)
+  {
+    stream.WriteInt(root);
+  }
+  stream << filter.required_flags.Raw() << filter.excluded_flags.Raw();
+  stream.WriteBoolean(static_cast<bool>(filter.type));
+  if (filter.type)
+  {
+    stream << filter.type;
+  }
+  stream << filter.tag;
+  return stream;
+}
+
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tStructureFilter& filter)
+{
+  uint64_t root_count = ReadVarInt(stream);
+  if (root_count > tStructureFilter::cMAX_ROOTS)
+  {
+    throw std::runtime_error("Structure filter has " + std::to_string(root_count) + " roots. Stream is corrupt.");
+  }
+  filter.roots.clear();
+  for (uint64_t i = 0; i < root_count; i++)
+  {
+    filter.roots.push_back(stream.ReadInt());
+  }
+  uint32_t required_flags, excluded_flags;
+  stream >> required_flags >> excluded_flags;
+  filter.required_flags = tStructureFilter::tFlags(required_flags);
+  filter.excluded_flags = tStructureFilter::tFlags(excluded_flags);
+  filter.type = rrlib::rtti::tType();
+  if (stream.ReadBoolean())
+  {
+    stream >> filter.type;
+  }
+  filter.tag = stream.ReadString();
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,144 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/structure_info/tStructureFilter.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tStructureFilter
+ *
+ * \b tStructureFilter
+ *
+ * Filter that a structure client can subscribe with - so that it only
+ * receives info on (and changes of) the part of the structure it is
+ * interested in (e.g. a GUI that shows a single module).
+ *
+ * Framework elements match if they are in one of the specified subtrees
+ * and match all specified flag, type and tag criteria.
+ * An empty filter matches all elements.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__structure_info__tStructureFilter_h__
+#define __plugins__network_transport__structure_info__tStructureFilter_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "core/port/tAbstractPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+namespace structure_info
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Filter for structure subscriptions
+/*!
+ * Selects the framework elements that a structure client receives info on.
+ * All criteria that are set must be met.
+ *
+ * Parents of matching elements are not included automatically - clients
+ * displaying a tree should subscribe to subtrees (optionally with flag criteria).
+ */
+struct tStructureFilter
+{
+  typedef core::tFrameworkElement::tHandle tHandle;
+  typedef core::tFrameworkElement::tFlags tFlags;
+
+  /*! Maximum number of subtree roots (filters with more roots are rejected on deserialization) */
+  enum { cMAX_ROOTS = 1024 };
+
+  /*! Handles of subtree roots - elements must be one of these or one of their descendants (empty: whole runtime environment) */
+  std::vector<tHandle> roots;
+
+  /*! Flags that elements must have */
+  tFlags required_flags;
+
+  /*! Flags that elements must not have */
+  tFlags excluded_flags;
+
+  /*! Data type of ports (no filtering by type if empty - otherwise, only ports can match) */
+  rrlib::rtti::tType type;
+
+  /*! Tag that elements must have (no filtering by tag if empty) */
+  std::string tag;
+
+
+  tStructureFilter() :
+    roots(),
+    required_flags(),
+    excluded_flags(),
+    type(),
+    tag()
+  {}
+
+  /*!
+   * \return Whether filter matches all elements (no criteria set)
+   */
+  bool MatchesAll() const
+  {
+    return roots.empty() && required_flags.Raw() == 0 && excluded_flags.Raw() == 0 && (!type) && tag.empty();
+  }
+
+  /*!
+   * \param element Framework element to check
+   * \return Whether element matches filter
+   */
+  bool Matches(const core::tFrameworkElement& element) const;
+
+  /*!
+   * Selects elements that match filter
+   *
+   * \param elements Framework elements to select from
+   * \param result Vector that matching elements are written to (in the same order; existing content is replaced)
+   */
+  void Select(const std::vector<core::tFrameworkElement*>& elements, std::vector<core::tFrameworkElement*>& result) const;
+};
+
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tStructureFilter& filter);
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tStructureFilter& filter);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,200 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tConnectionStatistics.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tConnectionStatistics.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkTransportPlugin.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tConnectionStatistics::tSnapshot::tSnapshot() :
+  transport(),
+  peer(),
+  bytes_sent(0),
+  bytes_received(0),
+  messages_sent(0),
+  messages_received(0),
+  queue_depth(0),
+  max_queue_depth(0),
+  serialization_time_ns(0),
+  serialization_count(0),
+  latency_histogram()
+{
+  latency_histogram.fill(0);
+}
+
+tConnectionStatistics::tConnectionStatistics(tNetworkTransportPlugin& plugin, const tRuntimeId& peer) :
+  plugin(plugin),
+  peer(peer),
+  bytes_sent(0),
+  bytes_received(0),
+  messages_sent(0),
+  messages_received(0),
+  queue_depth(0),
+  max_queue_depth(0),
+  serialization_time_ns(0),
+  serialization_count(0),
+  latency_histogram()
+{
+  Reset();
+}
+
+tConnectionStatistics::~tConnectionStatistics()
+{
+  plugin.RemoveConnectionStatistics(*this);
+}
+
+tConnectionStatistics::tSnapshot tConnectionStatistics::GetSnapshot() const
+{
+  tSnapshot snapshot;
+  snapshot.transport = plugin.GetName();
+  snapshot.peer = peer;
+  snapshot.bytes_sent = bytes_sent.load(std::memory_order_relaxed);
+  snapshot.bytes_received = bytes_received.load(std::memory_order_relaxed);
+  snapshot.messages_sent = messages_sent.load(std::memory_order_relaxed);
+  snapshot.messages_received = messages_received.load(std::memory_order_relaxed);
+  snapshot.queue_depth = queue_depth.load(std::memory_order_relaxed);
+  snapshot.max_queue_depth = max_queue_depth.load(std::memory_order_relaxed);
+  snapshot.serialization_time_ns = serialization_time_ns.load(std::memory_order_relaxed);
+  snapshot.serialization_count = serialization_count.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < cLATENCY_HISTOGRAM_BUCKETS; i++)
+  {
+    snapshot.latency_histogram[i] = latency_histogram[i].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+void tConnectionStatistics::RecordLatency(std::chrono::nanoseconds latency)
+{
+  uint64_t microseconds = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) / 1000 : 0;
+  size_t bucket = 0;
+  while (microseconds && bucket < cLATENCY_HISTOGRAM_BUCKETS - 1)
+  {
+    microseconds >>= 1;
+    bucket++;
+  }
+  latency_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void tConnectionStatistics::Reset()
+{
+  bytes_sent = 0;
+  bytes_received = 0;
+  messages_sent = 0;
+  messages_received = 0;
+  queue_depth = 0;
+  max_queue_depth = 0;
+  serialization_time_ns = 0;
+  serialization_count = 0;
+  for (auto & bucket : latency_histogram)
+  {
+    bucket = 0;
+  }
+}
+
+void tConnectionStatistics::SetQueueDepth(size_t depth)
+{
+  uint32_t value = static_cast<uint32_t>(depth);
+  queue_depth.store(value, std::memory_order_relaxed);
+  uint32_t maximum = max_queue_depth.load(std::memory_order_relaxed);
+  while (value > maximum && (!max_queue_depth.compare_exchange_weak(maximum, value, std::memory_order_relaxed)))
+  {}
+}
+
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tConnectionStatistics::tSnapshot& snapshot)
+{
+  stream << snapshot.transport << snapshot.peer;
+  stream << snapshot.bytes_sent << snapshot.bytes_received << snapshot.messages_sent << snapshot.messages_received;
+  stream << snapshot.queue_depth << snapshot.max_queue_depth;
+  stream << snapshot.serialization_time_ns << snapshot.serialization_count;
+  stream.WriteByte(tConnectionStatistics::cLATENCY_HISTOGRAM_BUCKETS);
+  for (uint64_t count : snapshot.latency_histogram)
+  {
+    stream << count;
+  }
+  return stream;
+}
+
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tConnectionStatistics::tSnapshot& snapshot)
+{
+  stream >> snapshot.transport >> snapshot.peer;
+  stream >> snapshot.bytes_sent >> snapshot.bytes_received >> snapshot.messages_sent >> snapshot.messages_received;
+  stream >> snapshot.queue_depth >> snapshot.max_queue_depth;
+  stream >> snapshot.serialization_time_ns >> snapshot.serialization_count;
+  size_t bucket_count = stream.ReadByte();
+  snapshot.latency_histogram.fill(0);
+  for (size_t i = 0; i < bucket_count; i++)
+  {
+    uint64_t count = 0;
+    stream >> count;
+    snapshot.latency_histogram[std::min<size_t>(i, tConnectionStatistics::cLATENCY_HISTOGRAM_BUCKETS - 1)] += count;
+  }
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,218 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tConnectionStatistics.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tConnectionStatistics
+ *
+ * \b tConnectionStatistics
+ *
+ * Statistics on the connection of a network transport to a single peer
+ * (bytes and messages sent/received, queue depth, serialization time and
+ * latency histogram). Attached as annotation to the framework element that
+ * represents the connection - and registered at the transport plugin, so that
+ * statistics of all transports can be obtained in a uniform way.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__tConnectionStatistics_h__
+#define __plugins__network_transport__tConnectionStatistics_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+#include <atomic>
+#include <chrono>
+#include "core/tFrameworkElement.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tRuntimeId.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tNetworkTransportPlugin;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Statistics on connection to peer
+/*!
+ * Annotation with statistics on the connection of a network transport to a single peer.
+ * Counters can be updated concurrently from any thread (lock-free).
+ * Should be created using tNetworkTransportPlugin::AddConnectionStatistics().
+ */
+class tConnectionStatistics : public core::tAnnotation
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Number of buckets in latency histogram.
+   * Bucket i counts latencies below 2^i microseconds (and at least 2^(i-1) microseconds).
+   * The last bucket also counts all larger latencies.
+   */
+  enum { cLATENCY_HISTOGRAM_BUCKETS = 24 };
+
+  /*!
+   * Values of statistics at a certain point in time
+   */
+  struct tSnapshot
+  {
+    /*! Name of transport plugin */
+    std::string transport;
+
+    /*! Peer that statistics refer to */
+    tRuntimeId peer;
+
+    /*! Bytes and messages sent to and received from peer */
+    uint64_t bytes_sent, bytes_received, messages_sent, messages_received;
+
+    /*! Current and maximum number of messages in send queue */
+    uint32_t queue_depth, max_queue_depth;
+
+    /*! Accumulated time spent serializing data for this peer (in nanoseconds) - and number of measurements */
+    uint64_t serialization_time_ns, serialization_count;
+
+    /*! Latency histogram (see cLATENCY_HISTOGRAM_BUCKETS) */
+    std::array<uint64_t, cLATENCY_HISTOGRAM_BUCKETS> latency_histogram;
+
+    tSnapshot();
+  };
+
+  ~tConnectionStatistics();
+
+  /*!
+   * \return Identifier of peer
+   */
+  const tRuntimeId& GetPeer() const
+  {
+    return peer;
+  }
+
+  /*!
+   * \return Current values of statistics
+   */
+  tSnapshot GetSnapshot() const;
+
+  /*!
+   * Records latency of a message (e.g. measured round-trip time / 2 or time from publishing to sending)
+   *
+   * \param latency Latency to record
+   */
+  void RecordLatency(std::chrono::nanoseconds latency);
+
+  /*!
+   * Records data received from peer
+   *
+   * \param bytes Number of bytes received
+   * \param messages Number of messages received
+   */
+  void RecordReceived(size_t bytes, size_t messages = 1)
+  {
+    bytes_received.fetch_add(bytes, std::memory_order_relaxed);
+    messages_received.fetch_add(messages, std::memory_order_relaxed);
+  }
+
+  /*!
+   * Records data sent to peer
+   *
+   * \param bytes Number of bytes sent
+   * \param messages Number of messages sent
+   */
+  void RecordSent(size_t bytes, size_t messages = 1)
+  {
+    bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+    messages_sent.fetch_add(messages, std::memory_order_relaxed);
+  }
+
+  /*!
+   * Records time spent serializing data for peer
+   *
+   * \param duration Time spent serializing
+   */
+  void RecordSerializationTime(std::chrono::nanoseconds duration)
+  {
+    serialization_time_ns.fetch_add(duration.count(), std::memory_order_relaxed);
+    serialization_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   * Resets all counters (e.g. after reconnect)
+   */
+  void Reset();
+
+  /*!
+   * \param queue_depth Current number of messages in send queue
+   */
+  void SetQueueDepth(size_t queue_depth);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  friend class tNetworkTransportPlugin;
+
+  /*! Transport plugin that statistics are registered at */
+  tNetworkTransportPlugin& plugin;
+
+  /*! Peer that statistics refer to */
+  const tRuntimeId peer;
+
+  std::atomic<uint64_t> bytes_sent, bytes_received, messages_sent, messages_received;
+  std::atomic<uint32_t> queue_depth, max_queue_depth;
+  std::atomic<uint64_t> serialization_time_ns, serialization_count;
+  std::array<std::atomic<uint64_t>, cLATENCY_HISTOGRAM_BUCKETS> latency_histogram;
+
+  /*! Created by tNetworkTransportPlugin::AddConnectionStatistics() */
+  tConnectionStatistics(tNetworkTransportPlugin& plugin, const tRuntimeId& peer);
+};
+
+
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tConnectionStatistics::tSnapshot& snapshot);
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tConnectionStatistics::tSnapshot& snapshot);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
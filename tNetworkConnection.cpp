@@ -69,20 +69,33 @@ namespace network_transport
 tNetworkConnection::tNetworkConnection() :
   encoding(tDestinationEncoding::NONE),
   destination_is_source(false),
-  uuid(),
-  port_handle(0)
+  runtime_id(),
+  port_handle(0),
+  uuid()
 {}
 
 tNetworkConnection::tNetworkConnection(const std::string& uuid, core::tFrameworkElement::tHandle handle, bool destination_is_source) :
   encoding(tDestinationEncoding::UUID_AND_HANDLE),
   destination_is_source(destination_is_source),
-  uuid(uuid),
-  port_handle(handle)
+  runtime_id(),
+  port_handle(handle),
+  uuid()
+{
+  SetUuid(uuid, tRuntimeId::Intern(uuid));
+}
+
+tNetworkConnection::tNetworkConnection(const tRuntimeId& runtime_id, core::tFrameworkElement::tHandle handle, bool destination_is_source) :
+  encoding(tDestinationEncoding::BINARY_UUID_AND_HANDLE),
+  destination_is_source(destination_is_source),
+  runtime_id(runtime_id),
+  port_handle(handle),
+  uuid()
 {}
 
 bool tNetworkConnection::operator==(const tNetworkConnection& other) const
 {
-  if (encoding != other.encoding)
+  // UUID_AND_HANDLE and BINARY_UUID_AND_HANDLE only differ in how the same destination is serialized
+  if ((encoding == tDestinationEncoding::NONE) != (other.encoding == tDestinationEncoding::NONE))
   {
     return false;
   }
@@ -91,26 +104,54 @@ bool tNetworkConnection::operator==(const tNetworkConnection& other) const
   case tDestinationEncoding::NONE:
     return true;
   case tDestinationEncoding::UUID_AND_HANDLE:
-    return uuid == other.uuid && port_handle == other.port_handle && destination_is_source == other.destination_is_source;
+  case tDestinationEncoding::BINARY_UUID_AND_HANDLE:
+    return runtime_id == other.runtime_id && port_handle == other.port_handle && destination_is_source == other.destination_is_source;
   default:
     FINROC_LOG_PRINT(ERROR, "Unsupported encoding");
     return false;
   }
 }
 
-rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tNetworkConnection& connection)
+void tNetworkConnection::Serialize(rrlib::serialization::tOutputStream& stream, bool binary_uuid) const
 {
-  stream << connection.encoding;
-  switch (connection.encoding)
+  switch (encoding)
   {
   case tDestinationEncoding::NONE:
+    stream << encoding;
     break;
   case tDestinationEncoding::UUID_AND_HANDLE:
-    stream << connection.uuid << connection.port_handle << connection.destination_is_source;
+  case tDestinationEncoding::BINARY_UUID_AND_HANDLE:
+    if (binary_uuid && runtime_id.IsCanonical())
+    {
+      stream << tDestinationEncoding::BINARY_UUID_AND_HANDLE << runtime_id;
+    }
+    else
+    {
+      stream << tDestinationEncoding::UUID_AND_HANDLE << (uuid.empty() ? runtime_id.ToString() : uuid);
+    }
+    stream << port_handle << destination_is_source;
     break;
   default:
-    FINROC_LOG_PRINT_STATIC(ERROR, "Unsupported encoding");
+    FINROC_LOG_PRINT(ERROR, "Unsupported encoding");
   }
+}
+
+void tNetworkConnection::SetUuid(const std::string& uuid_string, tRuntimeId id)
+{
+  runtime_id = id;
+  if ((!id.IsCanonical()) || id.ToString() != uuid_string)
+  {
+    uuid = uuid_string;
+  }
+  else
+  {
+    uuid.clear();
+  }
+}
+
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tNetworkConnection& connection)
+{
+  connection.Serialize(stream, false);
   return stream;
 }
 
@@ -120,9 +161,19 @@ rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStr
   switch (connection.encoding)
   {
   case tDestinationEncoding::NONE:
+    connection.uuid.clear();
     break;
   case tDestinationEncoding::UUID_AND_HANDLE:
-    stream >> connection.uuid >> connection.port_handle >> connection.destination_is_source;
+  {
+    // not interned: deserialization must not lock the intern table (original string is kept if necessary)
+    std::string uuid = stream.ReadString();
+    connection.SetUuid(uuid, tRuntimeId(uuid));
+    stream >> connection.port_handle >> connection.destination_is_source;
+    break;
+  }
+  case tDestinationEncoding::BINARY_UUID_AND_HANDLE:
+    connection.uuid.clear();
+    stream >> connection.runtime_id >> connection.port_handle >> connection.destination_is_source;
     break;
   default:
     FINROC_LOG_PRINT_STATIC(ERROR, "Unsupported encoding");
@@ -33,6 +33,8 @@
  * Encodes destination so that finstruct can identify connected port
  * in another runtime environment.
  *
+ * Network connections are trivially copyable: the UUID of the connected runtime
+ * environment is stored as compact tRuntimeId.
  */
 //----------------------------------------------------------------------
 #ifndef __plugins__network_transport__tNetworkConnection_h__
@@ -47,6 +49,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/network_transport/tRuntimeId.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -66,8 +69,9 @@ namespace network_transport
  */
 enum class tDestinationEncoding
 {
-  NONE,           //!< There is no destination encoded
-  UUID_AND_HANDLE //!< UUID of destination runtime environment and port handle
+  NONE,                  //!< There is no destination encoded
+  UUID_AND_HANDLE,        //!< UUID of destination runtime environment (as string) and port handle
+  BINARY_UUID_AND_HANDLE  //!< UUID of destination runtime environment (as 16 byte tRuntimeId) and port handle - only sent to peers that support it and for canonical UUIDs
 };
 
 //----------------------------------------------------------------------
@@ -89,10 +93,78 @@ public:
 
   tNetworkConnection();
 
+  /*!
+   * Creates connection with tDestinationEncoding::UUID_AND_HANDLE
+   * (UUID is interned - see tRuntimeId::Intern(); it is serialized exactly as passed)
+   */
   tNetworkConnection(const std::string& uuid, core::tFrameworkElement::tHandle handle, bool destination_is_source);
 
+  /*!
+   * Creates connection with tDestinationEncoding::BINARY_UUID_AND_HANDLE
+   */
+  tNetworkConnection(const tRuntimeId& runtime_id, core::tFrameworkElement::tHandle handle, bool destination_is_source);
+
+  /*!
+   * \return Encoding/Identification that is used for connected element in remote runtime environment
+   */
+  tDestinationEncoding GetEncoding() const
+  {
+    return encoding;
+  }
+
+  /*!
+   * \return Handle of connected port
+   */
+  core::tFrameworkElement::tHandle GetPortHandle() const
+  {
+    return port_handle;
+  }
+
+  /*!
+   * \return Identifier of connected runtime environment
+   */
+  const tRuntimeId& GetRuntimeId() const
+  {
+    return runtime_id;
+  }
+
+  /*!
+   * \return True if encoded destination port is the source/output port of this network connection
+   */
+  bool IsDestinationSource() const
+  {
+    return destination_is_source;
+  }
+
+  /*!
+   * Serializes connection.
+   * The stream operator is equivalent to calling this with binary_uuid = false
+   * (which is understood by all peers).
+   *
+   * \param stream Binary stream to serialize to
+   * \param binary_uuid Serialize UUID as 16 byte tRuntimeId? (may only be set if connection partner supports it; hashed UUIDs are always serialized as string)
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, bool binary_uuid) const;
+
   bool operator==(const tNetworkConnection& other) const;
 
+  bool operator!=(const tNetworkConnection& other) const
+  {
+    return !(*this == other);
+  }
+
+  /*!
+   * \return Hash value for hash tables (consistent with operator==)
+   */
+  size_t Hash() const
+  {
+    if (encoding == tDestinationEncoding::NONE)
+    {
+      return 0;
+    }
+    return runtime_id.Hash() ^ (static_cast<size_t>(port_handle) * 31 + (destination_is_source ? 1 : 0));
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -108,11 +180,22 @@ private:
   /*! True if encoded destination port is the source/output port of this network connection */
   bool destination_is_source;
 
-  /*! uuid of connected runtime environment - as string */
-  std::string uuid;
+  /*! Identifier of connected runtime environment */
+  tRuntimeId runtime_id;
 
   /*! Handle of connected port */
   core::tFrameworkElement::tHandle port_handle;
+
+  /*!
+   * UUID string as received or passed to constructor - only stored if runtime_id.ToString() does not
+   * return the same string (hashed UUIDs and canonical UUIDs not in lower case), so that it is sent
+   * to peers in string form exactly as it was received (empty otherwise - not allocating any memory)
+   */
+  std::string uuid;
+
+
+  /*! Sets runtime_id and uuid from UUID string */
+  void SetUuid(const std::string& uuid_string, tRuntimeId id);
 };
 
 
@@ -126,5 +209,19 @@ rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStr
 }
 }
 
+namespace std
+{
+
+template <>
+struct hash<finroc::network_transport::tNetworkConnection>
+{
+  size_t operator()(const finroc::network_transport::tNetworkConnection& connection) const
+  {
+    return connection.Hash();
+  }
+};
+
+}
+
 
 #endif
@@ -32,6 +32,9 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <array>
+#include <iterator>
+#include "rrlib/thread/tLock.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -66,55 +69,256 @@ namespace network_transport
 // Implementation
 //----------------------------------------------------------------------
 
+namespace
+{
+
+/*!
+ * Reverse index: remote runtime -> annotations with connections to this runtime
+ * (with number of connections per annotation).
+ * Split into stripes with separate mutexes, so that connecting ports to different
+ * runtime environments does not contend for the same lock.
+ */
+struct tReverseIndex
+{
+  enum { cSTRIPES = 16 };
+
+  struct tStripe
+  {
+    rrlib::thread::tMutex mutex;
+    std::unordered_map<tRuntimeId, std::unordered_map<tNetworkConnections*, size_t>> annotations;
+  };
+
+  std::array<tStripe, cSTRIPES> stripes;
+
+  tStripe& GetStripe(const tRuntimeId& runtime_id)
+  {
+    return stripes[runtime_id.Hash() % cSTRIPES];
+  }
+};
+
+tReverseIndex& GetReverseIndex()
+{
+  static tReverseIndex reverse_index;
+  return reverse_index;
+}
+
+void AddToReverseIndex(tNetworkConnections& annotation, const tNetworkConnection& connection)
+{
+  if (connection.GetEncoding() == tDestinationEncoding::NONE)
+  {
+    return;
+  }
+  tReverseIndex::tStripe& stripe = GetReverseIndex().GetStripe(connection.GetRuntimeId());
+  rrlib::thread::tLock lock(stripe.mutex);
+  stripe.annotations[connection.GetRuntimeId()][&annotation]++;
+}
+
+void RemoveFromReverseIndex(tNetworkConnections& annotation, const tRuntimeId& runtime_id, size_t connection_count)
+{
+  tReverseIndex::tStripe& stripe = GetReverseIndex().GetStripe(runtime_id);
+  rrlib::thread::tLock lock(stripe.mutex);
+  auto runtime_entry = stripe.annotations.find(runtime_id);
+  if (runtime_entry == stripe.annotations.end())
+  {
+    return;
+  }
+  auto annotation_entry = runtime_entry->second.find(&annotation);
+  if (annotation_entry == runtime_entry->second.end())
+  {
+    return;
+  }
+  assert(annotation_entry->second >= connection_count);
+  annotation_entry->second -= connection_count;
+  if (annotation_entry->second == 0)
+  {
+    runtime_entry->second.erase(annotation_entry);
+    if (runtime_entry->second.empty())
+    {
+      stripe.annotations.erase(runtime_entry);
+    }
+  }
+}
+
+void RemoveFromReverseIndex(tNetworkConnections& annotation, const tNetworkConnection& connection)
+{
+  if (connection.GetEncoding() != tDestinationEncoding::NONE)
+  {
+    RemoveFromReverseIndex(annotation, connection.GetRuntimeId(), 1);
+  }
+}
+
+}
+
 //----------------------------------------------------------------------
 // tNetworkConnections constructors
 //----------------------------------------------------------------------
 tNetworkConnections::tNetworkConnections() :
-  connections()
+  connections(),
+  index(),
+  in_reverse_index(false)
 {}
 
+tNetworkConnections::~tNetworkConnections()
+{
+  Clear();
+}
+
 void tNetworkConnections::Add(const tNetworkConnection& connection)
 {
-  for (size_t i = 0; i < connections.size(); i++)
+  if (index.find(connection) == index.end())
+  {
+    connections.push_back(connection);
+    index.emplace(connection, std::prev(connections.end()));
+    if (UpdateReverseIndexRegistration())
+    {
+      AddToReverseIndex(*this, connection);
+    }
+  }
+}
+
+void tNetworkConnections::Add(const std::vector<tNetworkConnection>& new_connections)
+{
+  index.reserve(connections.size() + new_connections.size());
+  for (const tNetworkConnection & connection : new_connections)
   {
-    if (connections[i] == connection)
+    Add(connection);
+  }
+}
+
+void tNetworkConnections::Clear()
+{
+  if (in_reverse_index)
+  {
+    for (const tNetworkConnection & connection : connections)
+    {
+      RemoveFromReverseIndex(*this, connection);
+    }
+  }
+  connections.clear();
+  index.clear();
+}
+
+std::vector<tNetworkConnections*> tNetworkConnections::GetAllConnectedTo(const tRuntimeId& runtime_id)
+{
+  std::vector<tNetworkConnections*> result;
+  tReverseIndex::tStripe& stripe = GetReverseIndex().GetStripe(runtime_id);
+  rrlib::thread::tLock lock(stripe.mutex);
+  auto runtime_entry = stripe.annotations.find(runtime_id);
+  if (runtime_entry != stripe.annotations.end())
+  {
+    result.reserve(runtime_entry->second.size());
+    for (auto & annotation_entry : runtime_entry->second)
     {
-      return;
+      result.push_back(annotation_entry.first);
     }
   }
-  connections.push_back(connection);
+  return result;
+}
+
+std::vector<core::tAbstractPort*> tNetworkConnections::GetPortsConnectedTo(const tRuntimeId& runtime_id)
+{
+  std::vector<core::tAbstractPort*> result;
+  for (tNetworkConnections * annotation : GetAllConnectedTo(runtime_id))
+  {
+    core::tAbstractPort* port = annotation->GetAnnotated<core::tAbstractPort>();
+    if (port)
+    {
+      result.push_back(port);
+    }
+  }
+  return result;
 }
 
 void tNetworkConnections::Remove(const tNetworkConnection& connection)
 {
-  for (size_t i = 0; i < connections.size(); i++)
+  auto it = index.find(connection);
+  if (it == index.end())
+  {
+    return;
+  }
+  connections.erase(it->second);
+  index.erase(it);
+  if (in_reverse_index)
   {
-    if (connections[i] == connection)
+    RemoveFromReverseIndex(*this, connection);
+  }
+}
+
+size_t tNetworkConnections::RemoveAll(const tRuntimeId& runtime_id)
+{
+  size_t removed = 0;
+  for (auto it = connections.begin(); it != connections.end();)
+  {
+    if (it->GetEncoding() != tDestinationEncoding::NONE && it->GetRuntimeId() == runtime_id)
+    {
+      index.erase(*it);
+      it = connections.erase(it);
+      removed++;
+    }
+    else
     {
-      connections.erase(connections.begin() + i);
-      i--;
+      ++it;
     }
   }
+  if (removed && in_reverse_index)
+  {
+    RemoveFromReverseIndex(*this, runtime_id, removed);
+  }
+  return removed;
+}
+
+bool tNetworkConnections::UpdateReverseIndexRegistration()
+{
+  if ((!in_reverse_index) && GetAnnotated<core::tAbstractPort>())
+  {
+    in_reverse_index = true;
+    for (const tNetworkConnection & connection : connections)
+    {
+      AddToReverseIndex(*this, connection);
+    }
+    return false;  // all connections (including the one just added) are now in index
+  }
+  return in_reverse_index;
+}
+
+size_t tNetworkConnections::RemoveAllConnectionsTo(const tRuntimeId& runtime_id)
+{
+  size_t removed = 0;
+  for (tNetworkConnections * annotation : GetAllConnectedTo(runtime_id))
+  {
+    removed += annotation->RemoveAll(runtime_id);
+  }
+  return removed;
+}
+
+void tNetworkConnections::Serialize(rrlib::serialization::tOutputStream& stream, bool binary_uuids) const
+{
+  stream.WriteInt(static_cast<uint>(connections.size()));
+  for (const tNetworkConnection & connection : connections)
+  {
+    connection.Serialize(stream, binary_uuids);
+  }
 }
 
 rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tNetworkConnections& connections)
 {
   stream.WriteInt(static_cast<uint>(connections.connections.size()));
-  for (size_t i = 0; i < connections.connections.size(); i++)
+  for (const tNetworkConnection & connection : connections.connections)
   {
-    stream << connections.connections[i];
+    stream << connection;
   }
   return stream;
 }
 
 rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tNetworkConnections& connections)
 {
-  connections.connections.clear();
+  connections.Clear();
   int count = stream.ReadInt();
+  tNetworkConnection connection;
   for (int i = 0; i < count; i++)
   {
-    connections.connections.emplace_back();
-    stream >> connections.connections.back();
+    stream >> connection;
+    connections.Add(connection);  // ignores duplicates (see class description)
   }
   return stream;
 }
@@ -31,6 +31,15 @@
  *
  * Annotation that manages and bundles all network connection that a port has.
  *
+ * Connections are indexed by a hash table, so that Add() and Remove() are O(1).
+ * As in the original list-based implementation, connections are iterated and serialized
+ * in the order they were added - removing connections does not change the order of the others.
+ * Connections are unique: duplicates are ignored by Add() - and also when deserializing
+ * (streams from the original implementation never contain duplicates, as its Add() also ignored them).
+ *
+ * A process-wide reverse index provides all annotations (and ports) with
+ * connections to a specific remote runtime environment. Only annotations that
+ * are attached to a port are indexed (temporary or deserialized ones are not).
  */
 //----------------------------------------------------------------------
 #ifndef __plugins__network_transport__tNetworkConnections_h__
@@ -39,6 +48,9 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <list>
+#include <unordered_map>
+#include "core/port/tAbstractPort.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -72,8 +84,16 @@ class tNetworkConnections : public core::tAnnotation
 //----------------------------------------------------------------------
 public:
 
+  typedef std::list<tNetworkConnection>::const_iterator tConstIterator;
+
   tNetworkConnections();
 
+  /*! Copying would bypass the reverse index */
+  tNetworkConnections(const tNetworkConnections&) = delete;
+  tNetworkConnections& operator=(const tNetworkConnections&) = delete;
+
+  ~tNetworkConnections();
+
   /*!
    * Adds specified connection if it is not in list yet
    *
@@ -81,14 +101,51 @@ public:
    */
   void Add(const tNetworkConnection& connection);
 
+  /*!
+   * Adds all specified connections that are not in list yet
+   *
+   * \param new_connections Connections to add
+   */
+  void Add(const std::vector<tNetworkConnection>& new_connections);
+
+  /*!
+   * \return Iterator to first network connection
+   */
+  tConstIterator Begin() const
+  {
+    return connections.begin();
+  }
+
   /*!
    * \return Number of network connections stored in this annotation
    */
-  size_t Count()
+  size_t Count() const
   {
     return connections.size();
   }
 
+  /*!
+   * \param runtime_id Identifier of remote runtime environment
+   * \return All network connection annotations with connections to specified runtime environment
+   */
+  static std::vector<tNetworkConnections*> GetAllConnectedTo(const tRuntimeId& runtime_id);
+
+  /*!
+   * (Caller should hold runtime's structure mutex, so that returned ports are not deleted concurrently)
+   *
+   * \param runtime_id Identifier of remote runtime environment
+   * \return All local ports with network connections to specified runtime environment
+   */
+  static std::vector<core::tAbstractPort*> GetPortsConnectedTo(const tRuntimeId& runtime_id);
+
+  /*!
+   * \return Iterator past last network connection
+   */
+  tConstIterator End() const
+  {
+    return connections.end();
+  }
+
   /*!
    * Removed specified connection if it is in list
    *
@@ -96,6 +153,35 @@ public:
    */
   void Remove(const tNetworkConnection& connection);
 
+  /*!
+   * Removes all connections to ports in specified runtime environment
+   * (order of remaining connections is preserved)
+   *
+   * \param runtime_id Identifier of remote runtime environment
+   * \return Number of connections that were removed
+   */
+  size_t RemoveAll(const tRuntimeId& runtime_id);
+
+  /*!
+   * Serializes connections with specified encoding of runtime UUIDs
+   * (same format as stream operator - which always serializes UUIDs as strings)
+   *
+   * \param stream Binary stream to serialize to
+   * \param binary_uuids Serialize UUIDs as 16 byte tRuntimeId? (only if connection partner negotiated tStructureEncodingFlag::BINARY_RUNTIME_IDS - otherwise as strings, as supported by all peers)
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream, bool binary_uuids) const;
+
+  /*!
+   * Removes all connections to ports in specified runtime environment from all annotations
+   * (e.g. when remote runtime environment disconnected).
+   * Cost is O(affected annotations) - as reverse index is used.
+   * (Caller should hold runtime's structure mutex, so that annotations are not deleted concurrently)
+   *
+   * \param runtime_id Identifier of remote runtime environment
+   * \return Number of connections that were removed
+   */
+  static size_t RemoveAllConnectionsTo(const tRuntimeId& runtime_id);
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -104,8 +190,26 @@ private:
   friend rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tNetworkConnections& connections);
   friend rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tNetworkConnections& connections);
 
-  /** Network connections of port */
-  std::vector<tNetworkConnection> connections;
+  /** Network connections of port (in the order they were added) */
+  std::list<tNetworkConnection> connections;
+
+  /** Position of each connection in 'connections' list */
+  std::unordered_map<tNetworkConnection, std::list<tNetworkConnection>::iterator> index;
+
+  /** Have connections of this annotation been added to reverse index? (as soon as annotation is attached to a port) */
+  bool in_reverse_index;
+
+
+  /*! Clears connections and index (also removes this annotation from reverse index) */
+  void Clear();
+
+  /*!
+   * Adds this annotation to reverse index - if it was attached to a port in the meantime
+   * (called whenever a connection is added)
+   *
+   * \return True if the connection just added still needs to be added to reverse index
+   */
+  bool UpdateReverseIndexRegistration();
 
 };
 
@@ -32,6 +32,10 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include "rrlib/thread/tLock.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -61,28 +65,354 @@ namespace network_transport
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
+const tNetworkTransportPlugin::tPluginHandle tNetworkTransportPlugin::cNO_PLUGIN;
 
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
+bool tTransportCost::IsCheaperThan(const tTransportCost& other) const
+{
+  if (reachability != other.reachability)
+  {
+    return reachability > other.reachability;
+  }
+  bool latency_known = latency.count() >= 0, other_latency_known = other.latency.count() >= 0;
+  if (latency_known != other_latency_known)
+  {
+    return latency_known;
+  }
+  if (latency_known && latency != other.latency)
+  {
+    return latency < other.latency;
+  }
+  return bandwidth > other.bandwidth;
+}
+
 namespace internal
 {
-std::vector<tNetworkTransportPlugin*>& GetPluginList()
+
+/*!
+ * Immutable snapshot of plugin registry.
+ * Registering a plugin publishes a new snapshot - so that readers do not need locks.
+ * Snapshots are never deleted, as readers might still use them (there are only few registrations).
+ */
+struct tPluginRegistry
+{
+  std::vector<tNetworkTransportPlugin*> plugins;
+  std::unordered_map<std::string, tNetworkTransportPlugin::tPluginHandle> by_name;
+  std::unordered_map<std::string, tNetworkTransportPlugin::tPluginHandle> by_protocol;
+};
+
+std::atomic<const tPluginRegistry*>& CurrentRegistry()
+{
+  static std::atomic<const tPluginRegistry*> registry(new tPluginRegistry());
+  return registry;
+}
+
+rrlib::thread::tMutex& RegistryMutex()
+{
+  static rrlib::thread::tMutex mutex;
+  return mutex;
+}
+
+/*!
+ * Publishes modified copy of current registry (caller must hold RegistryMutex())
+ */
+template <typename TModification>
+void ModifyRegistry(TModification modification)
 {
-  static std::vector<tNetworkTransportPlugin*> plugin_list;
-  return plugin_list;
+  tPluginRegistry* registry = new tPluginRegistry(*CurrentRegistry().load(std::memory_order_acquire));
+  modification(*registry);
+  CurrentRegistry().store(registry, std::memory_order_release);
 }
+
+/*!
+ * Plugins whose shutdown hook is registered - in registration order (guarded by RegistryMutex())
+ */
+std::vector<tNetworkTransportPlugin*>& ShutdownHooks()
+{
+  static std::vector<tNetworkTransportPlugin*> plugins;
+  return plugins;
+}
+
+/*!
+ * Calls shutdown hooks (registered with std::atexit) - in reverse registration order
+ */
+void CallShutdownHooks()
+{
+  std::vector<tNetworkTransportPlugin*> plugins;
+  {
+    rrlib::thread::tLock lock(RegistryMutex());
+    std::swap(plugins, ShutdownHooks());
+  }
+  for (auto it = plugins.rbegin(); it != plugins.rend(); ++it)
+  {
+    (*it)->Shutdown();
+  }
+}
+
 }
 
 tNetworkTransportPlugin::tNetworkTransportPlugin(const char* name) :
-  tConfigurablePlugin(name)
+  tConfigurablePlugin(name),
+  name(name),
+  plugin_handle(cNO_PLUGIN),
+  peer_capabilities_mutex(),
+  peer_capabilities(),
+  connection_statistics_mutex(),
+  connection_statistics(),
+  shutdown_hook_registration()
+{
+  rrlib::thread::tLock lock(internal::RegistryMutex());
+  internal::ModifyRegistry([this, name](internal::tPluginRegistry & registry)
+  {
+    plugin_handle = static_cast<tPluginHandle>(registry.plugins.size());
+    registry.plugins.push_back(this);
+    if (!registry.by_name.emplace(name, plugin_handle).second)
+    {
+      FINROC_LOG_PRINT(WARNING, "Network transport plugin with name '", name, "' is already registered");
+    }
+    registry.by_protocol.emplace(name, plugin_handle);
+  });
+}
+
+tConnectionStatistics& tNetworkTransportPlugin::AddConnectionStatistics(core::tFrameworkElement& connection_element, const tRuntimeId& peer)
+{
+  tConnectionStatistics* statistics = new tConnectionStatistics(*this, peer);
+  {
+    rrlib::thread::tLock lock(connection_statistics_mutex);
+    connection_statistics.push_back(statistics);
+  }
+  connection_element.AddAnnotation(statistics);
+  return *statistics;
+}
+
+tConnectionResult tNetworkTransportPlugin::ConnectUsingCheapestTransport(const tConnectionRequest& request, tNetworkTransportPlugin** used_plugin)
+{
+  if (used_plugin)
+  {
+    *used_plugin = nullptr;
+  }
+  if (!request.local_port)
+  {
+    return tConnectionResult(tConnectionError::INVALID_REQUEST, "No local port specified");
+  }
+  std::vector<tNetworkTransportPlugin*> transports = GetTransportsByCost(tRuntimeId(request.remote_runtime_uuid));
+  if (transports.empty())
+  {
+    return tConnectionResult(tConnectionError::REMOTE_RUNTIME_NOT_FOUND, "No network transport can reach runtime environment '" + request.remote_runtime_uuid + "'");
+  }
+  tConnectionResult result;
+  for (tNetworkTransportPlugin * transport : transports)
+  {
+    std::string error = transport->Connect(*request.local_port, request.remote_runtime_uuid, request.remote_port_handle, request.remote_port_link);
+    if (error.empty())
+    {
+      if (used_plugin)
+      {
+        *used_plugin = transport;
+      }
+      return tConnectionResult();
+    }
+    FINROC_LOG_PRINT_STATIC(DEBUG, "Connecting via ", transport->GetName(), " failed: ", error);
+    result = tConnectionResult(tConnectionError::OTHER, std::string(transport->GetName()) + ": " + error);
+  }
+  return result;
+}
+
+std::vector<std::string> tNetworkTransportPlugin::ConnectBatch(const std::vector<tConnectionRequest>& requests)
+{
+  std::vector<std::string> result;
+  result.reserve(requests.size());
+  for (const tConnectionRequest & request : requests)
+  {
+    if (!request.local_port)
+    {
+      result.emplace_back("No local port specified");
+      continue;
+    }
+    result.emplace_back(Connect(*request.local_port, request.remote_runtime_uuid, request.remote_port_handle, request.remote_port_link));
+  }
+  return result;
+}
+
+std::vector<std::string> tNetworkTransportPlugin::DisconnectBatch(const std::vector<tConnectionRequest>& requests)
+{
+  std::vector<std::string> result;
+  result.reserve(requests.size());
+  for (const tConnectionRequest & request : requests)
+  {
+    if (!request.local_port)
+    {
+      result.emplace_back("No local port specified");
+      continue;
+    }
+    result.emplace_back(Disconnect(*request.local_port, request.remote_runtime_uuid, request.remote_port_handle, request.remote_port_link));
+  }
+  return result;
+}
+
+void tNetworkTransportPlugin::ConnectAsync(const tConnectionRequest& request, const tCompletionHandler& completion_handler)
+{
+  if (!request.local_port)
+  {
+    completion_handler(tConnectionResult(tConnectionError::INVALID_REQUEST, "No local port specified"));
+    return;
+  }
+  std::string error = Connect(*request.local_port, request.remote_runtime_uuid, request.remote_port_handle, request.remote_port_link);
+  completion_handler(error.length() ? tConnectionResult(tConnectionError::OTHER, error) : tConnectionResult());
+}
+
+void tNetworkTransportPlugin::DisconnectAsync(const tConnectionRequest& request, const tCompletionHandler& completion_handler)
+{
+  if (!request.local_port)
+  {
+    completion_handler(tConnectionResult(tConnectionError::INVALID_REQUEST, "No local port specified"));
+    return;
+  }
+  std::string error = Disconnect(*request.local_port, request.remote_runtime_uuid, request.remote_port_handle, request.remote_port_link);
+  completion_handler(error.length() ? tConnectionResult(tConnectionError::OTHER, error) : tConnectionResult());
+}
+
+tTransportCost tNetworkTransportPlugin::EstimateCost(const tRuntimeId& remote_runtime) const
+{
+  return tTransportCost();
+}
+
+tNetworkTransportPlugin::tPluginHandle tNetworkTransportPlugin::FindByName(const std::string& name)
 {
-  internal::GetPluginList().push_back(this);
+  const internal::tPluginRegistry& registry = *internal::CurrentRegistry().load(std::memory_order_acquire);
+  auto it = registry.by_name.find(name);
+  return it != registry.by_name.end() ? it->second : cNO_PLUGIN;
+}
+
+tNetworkTransportPlugin::tPluginHandle tNetworkTransportPlugin::FindByProtocol(const std::string& protocol_id)
+{
+  const internal::tPluginRegistry& registry = *internal::CurrentRegistry().load(std::memory_order_acquire);
+  auto it = registry.by_protocol.find(protocol_id);
+  return it != registry.by_protocol.end() ? it->second : cNO_PLUGIN;
+}
+
+tNetworkTransportPlugin* tNetworkTransportPlugin::Get(tPluginHandle handle)
+{
+  const internal::tPluginRegistry& registry = *internal::CurrentRegistry().load(std::memory_order_acquire);
+  return handle < registry.plugins.size() ? registry.plugins[handle] : nullptr;
 }
 
 const std::vector<tNetworkTransportPlugin*>& tNetworkTransportPlugin::GetAll()
 {
-  return internal::GetPluginList();
+  return internal::CurrentRegistry().load(std::memory_order_acquire)->plugins;
+}
+
+std::vector<tConnectionStatistics::tSnapshot> tNetworkTransportPlugin::GetAllConnectionStatistics()
+{
+  std::vector<tConnectionStatistics::tSnapshot> result;
+  for (tNetworkTransportPlugin * plugin : GetAll())
+  {
+    std::vector<tConnectionStatistics::tSnapshot> plugin_statistics = plugin->GetConnectionStatistics();
+    result.insert(result.end(), plugin_statistics.begin(), plugin_statistics.end());
+  }
+  return result;
+}
+
+std::vector<tConnectionStatistics::tSnapshot> tNetworkTransportPlugin::GetConnectionStatistics() const
+{
+  rrlib::thread::tLock lock(connection_statistics_mutex);
+  std::vector<tConnectionStatistics::tSnapshot> result;
+  result.reserve(connection_statistics.size());
+  for (tConnectionStatistics * statistics : connection_statistics)
+  {
+    result.push_back(statistics->GetSnapshot());
+  }
+  return result;
+}
+
+tProtocolCapabilities tNetworkTransportPlugin::GetLocalCapabilities() const
+{
+  return tProtocolCapabilities::GetLocal();
+}
+
+tProtocolCapabilities tNetworkTransportPlugin::GetPeerCapabilities(const tRuntimeId& peer) const
+{
+  rrlib::thread::tLock lock(peer_capabilities_mutex);
+  auto it = peer_capabilities.find(peer);
+  return it != peer_capabilities.end() ? it->second : tProtocolCapabilities();
+}
+
+std::vector<tNetworkTransportPlugin*> tNetworkTransportPlugin::GetTransportsByCost(const tRuntimeId& remote_runtime)
+{
+  std::vector<std::pair<tTransportCost, tNetworkTransportPlugin*>> candidates;
+  for (tNetworkTransportPlugin * plugin : GetAll())
+  {
+    tTransportCost cost = plugin->EstimateCost(remote_runtime);
+    if (cost.reachability != tTransportCost::tReachability::UNREACHABLE)
+    {
+      candidates.emplace_back(cost, plugin);
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(), [](const std::pair<tTransportCost, tNetworkTransportPlugin*>& a, const std::pair<tTransportCost, tNetworkTransportPlugin*>& b)
+  {
+    return a.first.IsCheaperThan(b.first);
+  });
+  std::vector<tNetworkTransportPlugin*> result;
+  result.reserve(candidates.size());
+  for (auto & candidate : candidates)
+  {
+    result.push_back(candidate.second);
+  }
+  return result;
+}
+
+void tNetworkTransportPlugin::RegisterProtocol(const std::string& protocol_id)
+{
+  rrlib::thread::tLock lock(internal::RegistryMutex());
+  internal::ModifyRegistry([this, &protocol_id](internal::tPluginRegistry & registry)
+  {
+    auto result = registry.by_protocol.emplace(protocol_id, plugin_handle);
+    if ((!result.second) && result.first->second != plugin_handle)
+    {
+      FINROC_LOG_PRINT(WARNING, "Protocol ID '", protocol_id, "' is already registered by plugin '", registry.plugins[result.first->second]->GetName(), "'");
+    }
+  });
+}
+
+void tNetworkTransportPlugin::RegisterShutdownHook()
+{
+  std::call_once(shutdown_hook_registration, [this]()
+  {
+    rrlib::thread::tLock lock(internal::RegistryMutex());
+    if (internal::ShutdownHooks().empty())
+    {
+      std::atexit(internal::CallShutdownHooks);
+    }
+    internal::ShutdownHooks().push_back(this);
+  });
+}
+
+void tNetworkTransportPlugin::RemoveConnectionStatistics(tConnectionStatistics& statistics)
+{
+  rrlib::thread::tLock lock(connection_statistics_mutex);
+  connection_statistics.erase(std::remove(connection_statistics.begin(), connection_statistics.end(), &statistics), connection_statistics.end());
+}
+
+void tNetworkTransportPlugin::RemovePeerCapabilities(const tRuntimeId& peer)
+{
+  rrlib::thread::tLock lock(peer_capabilities_mutex);
+  peer_capabilities.erase(peer);
+}
+
+tNetworkTransportPlugin* tNetworkTransportPlugin::SelectTransport(const tRuntimeId& remote_runtime)
+{
+  std::vector<tNetworkTransportPlugin*> transports = GetTransportsByCost(remote_runtime);
+  return transports.empty() ? nullptr : transports.front();
+}
+
+tProtocolCapabilities tNetworkTransportPlugin::SetPeerCapabilities(const tRuntimeId& peer, const tProtocolCapabilities& remote_capabilities)
+{
+  tProtocolCapabilities negotiated = GetLocalCapabilities().Negotiate(remote_capabilities);
+  rrlib::thread::tLock lock(peer_capabilities_mutex);
+  peer_capabilities[peer] = negotiated;
+  return negotiated;
 }
 
 //----------------------------------------------------------------------
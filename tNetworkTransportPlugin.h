@@ -41,12 +41,20 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include "rrlib/thread/tMutex.h"
 #include "core/port/tAbstractPort.h"
 #include "plugins/parameters/tConfigurablePlugin.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/network_transport/tConnectionStatistics.h"
+#include "plugins/network_transport/tProtocolCapabilities.h"
+#include "plugins/network_transport/tRuntimeId.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -60,6 +68,91 @@ namespace network_transport
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
 
+/*!
+ * Error codes of connect and disconnect operations
+ */
+enum class tConnectionError
+{
+  NONE,                     //!< Operation succeeded
+  INVALID_REQUEST,          //!< Request is incomplete or invalid (e.g. no local port specified)
+  REMOTE_RUNTIME_NOT_FOUND, //!< Remote runtime environment is not known or not reachable
+  REMOTE_PORT_NOT_FOUND,    //!< Port does not exist in remote runtime environment
+  INCOMPATIBLE_PORTS,       //!< Ports cannot be connected (e.g. due to different data types)
+  CONNECTION_LOST,          //!< Connection to remote runtime environment was lost before operation completed
+  OTHER                     //!< Other error (see error message)
+};
+
+/*!
+ * Result of connect and disconnect operations
+ */
+struct tConnectionResult
+{
+  /*! Error code (tConnectionError::NONE on success) */
+  tConnectionError error;
+
+  /*! Error message (empty on success) */
+  std::string message;
+
+  tConnectionResult() :
+    error(tConnectionError::NONE),
+    message()
+  {}
+
+  tConnectionResult(tConnectionError error, const std::string& message) :
+    error(error),
+    message(message)
+  {}
+
+  /*!
+   * \return True if operation succeeded
+   */
+  bool Success() const
+  {
+    return error == tConnectionError::NONE;
+  }
+};
+
+/*!
+ * Estimated cost of connecting to a remote runtime environment using a certain transport
+ * (as reported by tNetworkTransportPlugin::EstimateCost())
+ */
+struct tTransportCost
+{
+  /*! Whether remote runtime environment can be reached */
+  enum class tReachability
+  {
+    UNREACHABLE, //!< Transport cannot reach remote runtime environment
+    UNKNOWN,     //!< Transport does not know (e.g. default implementation) - connecting may or may not work
+    REACHABLE    //!< Transport can reach remote runtime environment
+  };
+
+  tReachability reachability;
+
+  /*! Estimated latency (negative if unknown) */
+  std::chrono::nanoseconds latency;
+
+  /*! Estimated bandwidth in bytes per second (0 if unknown) */
+  uint64_t bandwidth;
+
+  tTransportCost() :
+    reachability(tReachability::UNKNOWN),
+    latency(-1),
+    bandwidth(0)
+  {}
+
+  tTransportCost(tReachability reachability, std::chrono::nanoseconds latency, uint64_t bandwidth) :
+    reachability(reachability),
+    latency(latency),
+    bandwidth(bandwidth)
+  {}
+
+  /*!
+   * \return True if this transport is preferable to the other one: reachable before unknown,
+   * then lower latency (unknown latency last), then higher bandwidth.
+   */
+  bool IsCheaperThan(const tTransportCost& other) const;
+};
+
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
@@ -69,6 +162,16 @@ namespace network_transport
  * for a whole finroc runtime environment.
  * One class in a Plugin must inherit from this interface.
  * It should be instantiated in a .cpp file.
+ *
+ * When connecting to a peer, plugins should send GetLocalCapabilities() and
+ * store the capabilities received from the peer using SetPeerCapabilities().
+ * GetPeerCapabilities() then provides the formats to use for this peer.
+ *
+ * Plugins that know whether (and how well) they can reach a peer should override
+ * EstimateCost(), so that ConnectUsingCheapestTransport() selects them when appropriate.
+ *
+ * For every connection to a peer, plugins should attach statistics using
+ * AddConnectionStatistics() and update them when sending and receiving data.
  */
 class tNetworkTransportPlugin : public parameters::tConfigurablePlugin
 {
@@ -78,11 +181,67 @@ class tNetworkTransportPlugin : public parameters::tConfigurablePlugin
 //----------------------------------------------------------------------
 public:
 
+  /*!
+   * Request to connect or disconnect a local port to/from a port in a remote runtime environment
+   * (parameters of the single-connection Connect() and Disconnect() methods bundled in a struct)
+   */
+  struct tConnectionRequest
+  {
+    /*! Local port to connect/disconnect */
+    core::tAbstractPort* local_port;
+
+    /*! UUID of remote runtime */
+    std::string remote_runtime_uuid;
+
+    /*! Handle of remote port */
+    int remote_port_handle;
+
+    /*! Link of port in remote runtime environment */
+    std::string remote_port_link;
+
+    tConnectionRequest() :
+      local_port(nullptr),
+      remote_runtime_uuid(),
+      remote_port_handle(0),
+      remote_port_link()
+    {}
+
+    tConnectionRequest(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid, int remote_port_handle, const std::string& remote_port_link) :
+      local_port(&local_port),
+      remote_runtime_uuid(remote_runtime_uuid),
+      remote_port_handle(remote_port_handle),
+      remote_port_link(remote_port_link)
+    {}
+  };
+
+  /*!
+   * Handler that is called when an asynchronous connect or disconnect operation has completed
+   */
+  typedef std::function<void (const tConnectionResult&)> tCompletionHandler;
+
+  /*!
+   * Stable handle of plugin in registry (index in registration order - plugins are never unregistered)
+   */
+  typedef uint32_t tPluginHandle;
+
+  /*! Handle returned if no plugin was found */
+  static const tPluginHandle cNO_PLUGIN = 0xFFFFFFFF;
+
   /*!
    * \param name Unique name of plugin. On Linux platforms, it should be identical with repository and .so file names (e.g. "tcp" for finroc_plugins_tcp and libfinroc_plugins_tcp.so).
    */
   tNetworkTransportPlugin(const char* name);
 
+  /*!
+   * Attaches statistics on the connection to specified peer to specified framework element
+   * (typically the element that represents the connection in this runtime environment).
+   * The statistics are registered at this plugin until the framework element is deleted.
+   *
+   * \param connection_element Framework element to attach statistics annotation to
+   * \param peer Identifier of remote runtime environment
+   * \return Statistics object to update
+   */
+  tConnectionStatistics& AddConnectionStatistics(core::tFrameworkElement& connection_element, const tRuntimeId& peer);
 
   /*!
    * Connect local port to port in remote runtime environment using this
@@ -110,16 +269,232 @@ public:
   virtual std::string Disconnect(core::tAbstractPort& local_port, const std::string& remote_runtime_uuid,
                                  int remote_port_handle, const std::string remote_port_link) = 0;
 
+  /*!
+   * Connects local port to port in remote runtime environment using the cheapest network
+   * transport plugin (see EstimateCost()). If connecting fails, the next-cheapest
+   * plugin that might reach the remote runtime environment is tried.
+   *
+   * \param request Connection request
+   * \param used_plugin If not nullptr, receives the plugin that was used for the connection (nullptr if connecting failed)
+   * \return Result of connect operation (of the last plugin that was tried)
+   */
+  static tConnectionResult ConnectUsingCheapestTransport(const tConnectionRequest& request, tNetworkTransportPlugin** used_plugin = nullptr);
+
+  /*!
+   * Connects multiple local ports to ports in remote runtime environments using this
+   * network transport plugin.
+   *
+   * The default implementation calls Connect() for every request.
+   * Plugins may override this in order to pipeline or coalesce the requests
+   * (e.g. by sending them to the remote runtime in a single message).
+   *
+   * \param requests Connection requests to process
+   * \return Returns one error message per request (same order as requests). Entries of successful requests are empty strings.
+   */
+  virtual std::vector<std::string> ConnectBatch(const std::vector<tConnectionRequest>& requests);
+
+  /*!
+   * Disconnects multiple local ports from ports in remote runtime environments
+   * (connections that were created using this transport plugin).
+   *
+   * The default implementation calls Disconnect() for every request.
+   * Plugins may override this in order to pipeline or coalesce the requests.
+   *
+   * \param requests Disconnect requests to process
+   * \return Returns one error message per request (same order as requests). Entries of successful requests are empty strings.
+   */
+  virtual std::vector<std::string> DisconnectBatch(const std::vector<tConnectionRequest>& requests);
+
+  /*!
+   * Connects local port to port in remote runtime environment without blocking the calling thread
+   * (provided the plugin overrides this method).
+   *
+   * The default implementation calls Connect() and invokes the completion handler
+   * before returning - errors are reported as tConnectionError::OTHER.
+   * Plugins should override this method if connecting involves waiting for the remote side.
+   * In this case, the completion handler may be called from another thread.
+   *
+   * \param request Connection request
+   * \param completion_handler Handler to call when operation has completed. Called exactly once.
+   */
+  virtual void ConnectAsync(const tConnectionRequest& request, const tCompletionHandler& completion_handler);
+
+  /*!
+   * Disconnects local port from port in remote runtime environment without blocking the calling thread
+   * (provided the plugin overrides this method).
+   *
+   * The default implementation calls Disconnect() and invokes the completion handler
+   * before returning - errors are reported as tConnectionError::OTHER.
+   * Plugins should override this method if disconnecting involves waiting for the remote side.
+   * In this case, the completion handler may be called from another thread.
+   *
+   * \param request Disconnect request
+   * \param completion_handler Handler to call when operation has completed. Called exactly once.
+   */
+  virtual void DisconnectAsync(const tConnectionRequest& request, const tCompletionHandler& completion_handler);
+
+  /*!
+   * Looks up plugin by name (O(1), lock-free)
+   *
+   * \param name Unique name of plugin
+   * \return Handle of plugin - or cNO_PLUGIN if there is no plugin with this name
+   */
+  static tPluginHandle FindByName(const std::string& name);
+
+  /*!
+   * Looks up plugin by protocol ID (O(1), lock-free)
+   *
+   * \param protocol_id Protocol ID (e.g. as passed to tRemoteRuntime constructor)
+   * \return Handle of plugin - or cNO_PLUGIN if no plugin registered this protocol ID
+   */
+  static tPluginHandle FindByProtocol(const std::string& protocol_id);
+
+  /*!
+   * Estimates cost of connecting to specified remote runtime environment using this plugin.
+   * Should be cheap to call (e.g. not involve network communication).
+   *
+   * \param remote_runtime Identifier of remote runtime environment
+   * \return Estimated cost. The default implementation returns a cost with unknown reachability, latency and bandwidth.
+   */
+  virtual tTransportCost EstimateCost(const tRuntimeId& remote_runtime) const;
+
+  /*!
+   * \param handle Handle of plugin
+   * \return Plugin with specified handle (O(1), lock-free) - or nullptr if handle is invalid
+   */
+  static tNetworkTransportPlugin* Get(tPluginHandle handle);
+
   /*!
    * \return Returns a list of all network transport plugins that have been registered for current finroc runtime environment
+   * (safe to use from any thread - list is a snapshot that remains valid when further plugins are registered)
    */
   static const std::vector<tNetworkTransportPlugin*>& GetAll();
 
+  /*!
+   * \return Snapshot of statistics on all connections of this plugin
+   */
+  std::vector<tConnectionStatistics::tSnapshot> GetConnectionStatistics() const;
+
+  /*!
+   * \return Snapshot of statistics on all connections of all network transport plugins in this runtime environment
+   */
+  static std::vector<tConnectionStatistics::tSnapshot> GetAllConnectionStatistics();
+
+  /*!
+   * \return Capabilities that this plugin supports (sent to peers on connect). By default, all capabilities of network_transport.
+   */
+  virtual tProtocolCapabilities GetLocalCapabilities() const;
+
+  /*!
+   * \param peer Identifier of remote runtime environment
+   * \return Negotiated capabilities for connection to specified peer (default-constructed if no capabilities were received from this peer)
+   */
+  tProtocolCapabilities GetPeerCapabilities(const tRuntimeId& peer) const;
+
+  /*!
+   * \return Handle of this plugin in registry
+   */
+  tPluginHandle GetHandle() const
+  {
+    return plugin_handle;
+  }
+
+  /*!
+   * \return Unique name of plugin (as passed to constructor)
+   */
+  const char* GetName() const
+  {
+    return name;
+  }
+
+  /*!
+   * \param remote_runtime Identifier of remote runtime environment
+   * \return All network transport plugins that might reach specified runtime environment - cheapest first
+   */
+  static std::vector<tNetworkTransportPlugin*> GetTransportsByCost(const tRuntimeId& remote_runtime);
+
+  /*!
+   * Registers protocol ID for this plugin, so that FindByProtocol() returns it.
+   * The plugin name is registered as protocol ID automatically.
+   *
+   * \param protocol_id Protocol ID
+   */
+  void RegisterProtocol(const std::string& protocol_id);
+
+  /*!
+   * Removes capabilities stored for specified peer (e.g. when connection is closed)
+   *
+   * \param peer Identifier of remote runtime environment
+   */
+  void RemovePeerCapabilities(const tRuntimeId& peer);
+
+  /*!
+   * \param remote_runtime Identifier of remote runtime environment
+   * \return Cheapest network transport plugin that might reach specified runtime environment (nullptr if there is none)
+   */
+  static tNetworkTransportPlugin* SelectTransport(const tRuntimeId& remote_runtime);
+
+  /*!
+   * Negotiates and stores capabilities for connection to specified peer
+   *
+   * \param peer Identifier of remote runtime environment
+   * \param remote_capabilities Capabilities received from peer (in connect handshake)
+   * \return Negotiated capabilities (supported by both sides)
+   */
+  tProtocolCapabilities SetPeerCapabilities(const tRuntimeId& peer, const tProtocolCapabilities& remote_capabilities);
+
+  /*!
+   * Shutdown hook: Called once on program exit if RegisterShutdownHook() was called - before static objects are destroyed.
+   * Plugins stop their threads and unregister from the runtime environment here
+   * (plugin instances are static objects - so the runtime environment may already be deleted in their destructors).
+   */
+  virtual void Shutdown() {}
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*!
+   * Registers Shutdown() to be called on program exit.
+   * Must be called after the runtime environment has been created (e.g. in Init()) - so that
+   * Shutdown() is called before the runtime environment is deleted. Further calls have no effect.
+   */
+  void RegisterShutdownHook();
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  friend class tConnectionStatistics;
+
+  /*! Unique name of plugin */
+  const char* const name;
+
+  /*! Handle of this plugin in registry */
+  tPluginHandle plugin_handle;
+
+  /*! Mutex for peer_capabilities */
+  mutable rrlib::thread::tMutex peer_capabilities_mutex;
+
+  /*! Negotiated capabilities for connections to peers */
+  std::unordered_map<tRuntimeId, tProtocolCapabilities> peer_capabilities;
+
+  /*! Mutex for connection_statistics */
+  mutable rrlib::thread::tMutex connection_statistics_mutex;
+
+  /*! Statistics on all connections of this plugin */
+  std::vector<tConnectionStatistics*> connection_statistics;
+
+  /*! Has shutdown hook been registered? */
+  std::once_flag shutdown_hook_registration;
+
+  /*!
+   * Unregisters statistics (called by tConnectionStatistics destructor)
+   */
+  void RemoveConnectionStatistics(tConnectionStatistics& statistics);
+
 };
 
 //----------------------------------------------------------------------
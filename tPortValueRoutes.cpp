@@ -0,0 +1,215 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tPortValueRoutes.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tPortValueRoutes.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "core/tRuntimeEnvironment.h"
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tPortValueRoutes::tPortValueRoutes(const tSendFunction& send_function) :
+  mutex(),
+  send_function(send_function),
+  routes(),
+  port_listeners()
+{}
+
+bool tPortValueRoutes::Add(core::tAbstractPort& source_port, const tRoute& route)
+{
+  rrlib::thread::tLock lock(mutex);
+  std::vector<tRoute>& port_routes = routes[source_port.GetHandle()];
+  if (std::find(port_routes.begin(), port_routes.end(), route) != port_routes.end())
+  {
+    return false;
+  }
+  port_routes.push_back(route);
+  if (port_listeners.find(source_port.GetHandle()) == port_listeners.end())
+  {
+    std::unique_ptr<tPortListener> listener(new tPortListener(*this, source_port.GetHandle()));
+    data_ports::tGenericPort::Wrap(source_port).AddPortListener(*listener);
+    port_listeners.emplace(source_port.GetHandle(), std::move(listener));
+  }
+  return true;
+}
+
+void tPortValueRoutes::DetachListener(core::tAbstractPort& port, std::unique_ptr<tPortListener>& listener)
+{
+  if (listener)
+  {
+    data_ports::tGenericPort::Wrap(port).RemovePortListener(*listener);
+    listener.reset();
+  }
+}
+
+bool tPortValueRoutes::PublishValue(tHandle handle, rrlib::serialization::tInputStream& stream)
+{
+  core::tAbstractPort* port = core::tRuntimeEnvironment::GetInstance().GetPort(handle);
+  if (!(port && port->IsReady()))
+  {
+    return false;
+  }
+  data_ports::tGenericPort generic_port = data_ports::tGenericPort::Wrap(*port);
+  data_ports::tPortDataPointer<rrlib::rtti::tGenericObject> value = generic_port.GetUnusedBuffer();
+  value->Deserialize(stream);
+  generic_port.Publish(value);
+  return true;
+}
+
+bool tPortValueRoutes::Remove(core::tAbstractPort& source_port, const tRoute& route)
+{
+  std::unique_ptr<tPortListener> listener;
+  {
+    rrlib::thread::tLock lock(mutex);
+    auto it = routes.find(source_port.GetHandle());
+    if (it == routes.end())
+    {
+      return false;
+    }
+    auto route_it = std::find(it->second.begin(), it->second.end(), route);
+    if (route_it == it->second.end())
+    {
+      return false;
+    }
+    it->second.erase(route_it);
+    if (it->second.empty())
+    {
+      routes.erase(it);
+      auto listener_it = port_listeners.find(source_port.GetHandle());
+      if (listener_it != port_listeners.end())
+      {
+        listener = std::move(listener_it->second);
+        port_listeners.erase(listener_it);
+      }
+    }
+  }
+  DetachListener(source_port, listener);
+  return true;
+}
+
+void tPortValueRoutes::RemovePort(core::tAbstractPort& port)
+{
+  std::unique_ptr<tPortListener> listener;
+  {
+    rrlib::thread::tLock lock(mutex);
+    routes.erase(port.GetHandle());
+    auto it = port_listeners.find(port.GetHandle());
+    if (it != port_listeners.end())
+    {
+      listener = std::move(it->second);
+      port_listeners.erase(it);
+    }
+  }
+  DetachListener(port, listener);
+}
+
+void tPortValueRoutes::RemoveRoutes(const std::function<bool (const tRoute& route)>& predicate)
+{
+  std::vector<std::pair<tHandle, std::unique_ptr<tPortListener>>> unused_listeners;
+  {
+    rrlib::thread::tLock lock(mutex);
+    for (auto it = routes.begin(); it != routes.end();)
+    {
+      it->second.erase(std::remove_if(it->second.begin(), it->second.end(), predicate), it->second.end());
+      if (it->second.empty())
+      {
+        auto listener_it = port_listeners.find(it->first);
+        if (listener_it != port_listeners.end())
+        {
+          unused_listeners.emplace_back(it->first, std::move(listener_it->second));
+          port_listeners.erase(listener_it);
+        }
+        it = routes.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+  for (auto & entry : unused_listeners)
+  {
+    core::tAbstractPort* port = core::tRuntimeEnvironment::GetInstance().GetPort(entry.first);
+    if (port)
+    {
+      DetachListener(*port, entry.second);
+    }
+  }
+}
+
+void tPortValueRoutes::Send(tHandle handle, const rrlib::rtti::tGenericObject& value)
+{
+  rrlib::thread::tLock lock(mutex);
+  auto it = routes.find(handle);
+  if (it != routes.end())
+  {
+    send_function(handle, it->second, value);
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
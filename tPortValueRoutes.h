@@ -0,0 +1,208 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tPortValueRoutes.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tPortValueRoutes
+ *
+ * \b tPortValueRoutes
+ *
+ * Routes of local source ports to ports of peers - for network transports
+ * that forward every value of a connected data port (e.g. shared memory
+ * and loopback transport). Manages the port listeners attached to the
+ * source ports and contains the common receive path (publishing a
+ * deserialized value via a local port).
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__tPortValueRoutes_h__
+#define __plugins__network_transport__tPortValueRoutes_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <functional>
+#include <unordered_map>
+#include "plugins/data_ports/tGenericPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tRuntimeId.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Routes of local source ports to remote ports
+/*!
+ * Stores to which ports of which peers the values of local source ports are forwarded.
+ * A port listener is attached to a source port as long as it has at least one route.
+ * When a source port changes, the send function is called with all routes of this port.
+ *
+ * Methods that add or remove routes must be called with the runtime's structure mutex held.
+ * Listeners are detached from ports before they are deleted.
+ */
+class tPortValueRoutes
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef core::tFrameworkElement::tHandle tHandle;
+
+  /*! Destination of values of a source port */
+  struct tRoute
+  {
+    tRuntimeId peer;
+    tHandle remote_handle;
+
+    bool operator==(const tRoute& other) const
+    {
+      return peer == other.peer && remote_handle == other.remote_handle;
+    }
+  };
+
+  /*!
+   * Function that sends value of source port along the specified routes
+   * (called by the thread that published the value - with mutex of tPortValueRoutes held)
+   */
+  typedef std::function<void (tHandle source_handle, const std::vector<tRoute>& routes, const rrlib::rtti::tGenericObject& value)> tSendFunction;
+
+  /*!
+   * \param send_function Function that sends values of source ports
+   */
+  explicit tPortValueRoutes(const tSendFunction& send_function);
+
+  /*!
+   * Adds route (attaches port listener to source port if it has no routes yet)
+   *
+   * \param source_port Local source port
+   * \param route Route to add
+   * \return False if route already existed
+   */
+  bool Add(core::tAbstractPort& source_port, const tRoute& route);
+
+  /*!
+   * Deserializes value from stream and publishes it via local port with specified handle.
+   * The port is looked up without acquiring the runtime's structure mutex (this is called for every received value).
+   *
+   * \param handle Handle of local port
+   * \param stream Stream to deserialize value from
+   * \return True if port exists and value was published
+   */
+  static bool PublishValue(tHandle handle, rrlib::serialization::tInputStream& stream);
+
+  /*!
+   * Removes route (detaches port listener from source port if this was its last route)
+   *
+   * \param source_port Local source port
+   * \param route Route to remove
+   * \return False if there was no such route
+   */
+  bool Remove(core::tAbstractPort& source_port, const tRoute& route);
+
+  /*!
+   * Removes all routes of port and detaches port listener
+   * (to be called when port is deleted)
+   *
+   * \param port Port that is deleted
+   */
+  void RemovePort(core::tAbstractPort& port);
+
+  /*!
+   * Removes all routes for which the specified predicate returns true
+   *
+   * \param predicate Predicate
+   */
+  void RemoveRoutes(const std::function<bool (const tRoute& route)>& predicate);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Forwards changed values of a local source port */
+  class tPortListener
+  {
+  public:
+    tPortListener(tPortValueRoutes& routes, tHandle handle) :
+      routes(routes),
+      handle(handle)
+    {}
+
+    void OnPortChange(const rrlib::rtti::tGenericObject& value, data_ports::tChangeContext& change_context)
+    {
+      routes.Send(handle, value);
+    }
+
+  private:
+    tPortValueRoutes& routes;
+    tHandle handle;
+  };
+
+  /*! Mutex for all variables below */
+  rrlib::thread::tMutex mutex;
+
+  /*! Function that sends values of source ports */
+  tSendFunction send_function;
+
+  /*! Routes of source ports (key is local port handle) */
+  std::unordered_map<tHandle, std::vector<tRoute>> routes;
+
+  /*! Port listeners attached to source ports (key is local port handle) */
+  std::unordered_map<tHandle, std::unique_ptr<tPortListener>> port_listeners;
+
+
+  /*!
+   * Detaches listener from port and deletes it
+   * (must be called without holding mutex - as port may be notifying listener concurrently)
+   */
+  static void DetachListener(core::tAbstractPort& port, std::unique_ptr<tPortListener>& listener);
+
+  /*! Sends value of source port along all its routes */
+  void Send(tHandle handle, const rrlib::rtti::tGenericObject& value);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
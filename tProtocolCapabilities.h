@@ -0,0 +1,142 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tProtocolCapabilities.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tProtocolCapabilities
+ *
+ * \b tProtocolCapabilities
+ *
+ * Capabilities of a peer regarding the formats that network_transport provides
+ * (currently the optional structure encodings).
+ *
+ * Peers exchange their capabilities when they connect (handshake).
+ * Each side then negotiates the capabilities that both support - and uses
+ * the most compact formats in this set for the connection.
+ * A peer that does not send capabilities (older versions) is represented by
+ * a default-constructed instance: no optional formats are used then.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__tProtocolCapabilities_h__
+#define __plugins__network_transport__tProtocolCapabilities_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/structure_info/tStructureEncoding.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Protocol capabilities of a peer
+/*!
+ * Capabilities of a peer regarding the formats that network_transport provides.
+ * Exchanged when peers connect - and negotiated to the capabilities both support.
+ * A default-constructed instance represents peers that do not support capability exchange.
+ */
+struct tProtocolCapabilities
+{
+  /*! Version of capability handshake supported by this implementation */
+  enum { cCURRENT_VERSION = 1 };
+
+  /*! Version of capability handshake (0 for peers that do not support it) */
+  uint16_t version;
+
+  /*! Supported optional structure encodings */
+  tStructureEncodingFlags structure_encodings;
+
+
+  tProtocolCapabilities() :
+    version(0),
+    structure_encodings()
+  {}
+
+  tProtocolCapabilities(uint16_t version, tStructureEncodingFlags structure_encodings) :
+    version(version),
+    structure_encodings(structure_encodings)
+  {}
+
+  /*!
+   * \return Capabilities of this implementation (everything it supports)
+   */
+  static tProtocolCapabilities GetLocal();
+
+  /*!
+   * \param remote Capabilities of remote peer (as received in handshake)
+   * \return Capabilities both this and remote peer support
+   */
+  tProtocolCapabilities Negotiate(const tProtocolCapabilities& remote) const
+  {
+    return tProtocolCapabilities(std::min(version, remote.version), structure_encodings & remote.structure_encodings);
+  }
+
+  /*!
+   * \return Encoding state for structure exchange that uses negotiated structure encodings
+   */
+  tStructureEncodingState CreateStructureEncodingState() const
+  {
+    return tStructureEncodingState(structure_encodings);
+  }
+};
+
+inline rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tProtocolCapabilities& capabilities)
+{
+  stream << capabilities.version << capabilities.structure_encodings.Raw();
+  return stream;
+}
+
+inline rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tProtocolCapabilities& capabilities)
+{
+  uint32_t structure_encodings = 0;
+  stream >> capabilities.version >> structure_encodings;
+  capabilities.structure_encodings = tStructureEncodingFlags(structure_encodings);
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,145 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tQualityOfService.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tQualityOfService
+ *
+ * \b tQualityOfService
+ *
+ * Quality of service settings of a port: priority class and latency budget.
+ * Stored in an annotation of local ports. Exchanged with peers as part of
+ * tChangeablePortInfo (if both support tStructureEncodingFlag::QOS_INFO).
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__tQualityOfService_h__
+#define __plugins__network_transport__tQualityOfService_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "core/port/tAbstractPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*!
+ * Priority classes of ports. Network transports send updates of ports with
+ * higher priority class first (see tSendScheduler).
+ */
+enum class tPortPriority : uint8_t
+{
+  BULK,      //!< Large, latency-insensitive data (e.g. maps, logging)
+  NORMAL,    //!< Default
+  HIGH,      //!< Latency-sensitive data (e.g. sensor values used in control loops)
+  REAL_TIME  //!< Control values - sent before anything else
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Quality of service settings of a port
+/*!
+ * Quality of service settings of a port.
+ * Settings of local ports are stored in a tQualityOfServiceAnnotation.
+ * Ports without this annotation have priority NORMAL and no latency budget.
+ *
+ * Settings must be made before the port is initialized: they are sent to peers
+ * as part of the port's info when the port is added - and changing them does not
+ * notify peers.
+ */
+struct tQualityOfService
+{
+  /*! Priority class of port */
+  tPortPriority priority;
+
+  /*! Latency budget in ms - time within which updates should be sent (-1 if there is none) */
+  int16_t latency_budget;
+
+
+  tQualityOfService(tPortPriority priority = tPortPriority::NORMAL, int16_t latency_budget = -1) :
+    priority(priority),
+    latency_budget(latency_budget)
+  {}
+
+  /*!
+   * \param value Priority class as received from a peer
+   * \return Corresponding priority class (values beyond the known classes are clamped to REAL_TIME)
+   */
+  static tPortPriority ToPortPriority(uint8_t value)
+  {
+    return static_cast<tPortPriority>(std::min<uint8_t>(value, static_cast<uint8_t>(tPortPriority::REAL_TIME)));
+  }
+
+  /*!
+   * \param port Port to get settings of
+   * \return Quality of service settings of port (defaults if port has no annotation)
+   */
+  static tQualityOfService Get(const core::tAbstractPort& port);
+
+  /*!
+   * Sets quality of service settings of port (adds annotation if port has none).
+   * Must be called before port is initialized (peers are not notified of later changes).
+   *
+   * \param port Port to set settings of
+   * \param settings New settings
+   */
+  static void Set(core::tAbstractPort& port, const tQualityOfService& settings);
+};
+
+/*!
+ * Annotation that stores quality of service settings of a local port
+ * (use tQualityOfService::Get() and tQualityOfService::Set() to access it)
+ */
+class tQualityOfServiceAnnotation : public core::tAnnotation
+{
+public:
+
+  /*! Quality of service settings of annotated port */
+  tQualityOfService settings;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
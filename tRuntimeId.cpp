@@ -0,0 +1,226 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tRuntimeId.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tRuntimeId.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <unordered_map>
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Length of UUID in canonical text form */
+static const size_t cCANONICAL_UUID_LENGTH = 36;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+/*!
+ * Table with interned UUID strings (of hashed identifiers only)
+ */
+struct tInternTable
+{
+  rrlib::thread::tMutex mutex;
+  std::unordered_map<tRuntimeId, std::string> strings;
+};
+
+tInternTable& GetInternTable()
+{
+  static tInternTable table;
+  return table;
+}
+
+int HexDigitValue(char c)
+{
+  if (c >= '0' && c <= '9')
+  {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f')
+  {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F')
+  {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/*!
+ * Parses UUID in canonical text form (8-4-4-4-12 hex digits)
+ *
+ * \return True if uuid has canonical form (result is only valid in this case)
+ */
+bool ParseCanonicalUuid(const std::string& uuid, uint64_t& high, uint64_t& low)
+{
+  if (uuid.length() != cCANONICAL_UUID_LENGTH)
+  {
+    return false;
+  }
+  high = 0;
+  low = 0;
+  int digit_count = 0;
+  for (size_t i = 0; i < uuid.length(); i++)
+  {
+    if (i == 8 || i == 13 || i == 18 || i == 23)
+    {
+      if (uuid[i] != '-')
+      {
+        return false;
+      }
+      continue;
+    }
+    int value = HexDigitValue(uuid[i]);
+    if (value < 0)
+    {
+      return false;
+    }
+    uint64_t& target = digit_count < 16 ? high : low;
+    target = (target << 4) | static_cast<uint64_t>(value);
+    digit_count++;
+  }
+  return true;
+}
+
+/*!
+ * 64 bit FNV-1a hash with specified offset basis
+ */
+uint64_t HashString(const std::string& s, uint64_t offset_basis)
+{
+  uint64_t hash = offset_basis;
+  for (char c : s)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+}
+
+tRuntimeId::tRuntimeId(const std::string& uuid) :
+  high(0),
+  low(0)
+{
+  if (!ParseCanonicalUuid(uuid, high, low))
+  {
+    high = HashString(uuid, 0xCBF29CE484222325ULL);
+    low = HashString(uuid, 0x84222325CBF29CE4ULL) | cHASH_TAG_MASK;
+  }
+}
+
+tRuntimeId tRuntimeId::Intern(const std::string& uuid)
+{
+  tRuntimeId result(uuid);
+  if (result.IsCanonical())
+  {
+    return result;
+  }
+
+  tInternTable& table = GetInternTable();
+  rrlib::thread::tLock lock(table.mutex);
+  auto it = table.strings.find(result);
+  if (it == table.strings.end())
+  {
+    table.strings.emplace(result, uuid);
+  }
+  else if (it->second != uuid)
+  {
+    FINROC_LOG_PRINT_STATIC(WARNING, "Runtime UUIDs '", it->second, "' and '", uuid, "' map to the same identifier. Peers might not be distinguishable.");
+  }
+  return result;
+}
+
+std::string tRuntimeId::ToString() const
+{
+  if (!IsCanonical())
+  {
+    tInternTable& table = GetInternTable();
+    rrlib::thread::tLock lock(table.mutex);
+    auto it = table.strings.find(*this);
+    if (it != table.strings.end())
+    {
+      return it->second;
+    }
+  }
+
+  static const char* cHEX_DIGITS = "0123456789abcdef";
+  std::string result;
+  result.reserve(cCANONICAL_UUID_LENGTH);
+  for (int i = 0; i < 32; i++)
+  {
+    if (i == 8 || i == 12 || i == 16 || i == 20)
+    {
+      result += '-';
+    }
+    uint64_t part = i < 16 ? high : low;
+    result += cHEX_DIGITS[(part >> (60 - 4 * (i % 16))) & 0xF];
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,227 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tRuntimeId.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tRuntimeId
+ *
+ * \b tRuntimeId
+ *
+ * Compact 128 bit identifier of a runtime environment.
+ *
+ * Runtime UUIDs in canonical text form (e.g. "123e4567-e89b-12d3-a456-426655440000")
+ * are converted to their 16 binary bytes. Any other UUID string (e.g. "host:port")
+ * is mapped to a 128 bit hash of the string - so that every peer derives the same
+ * identifier from the same UUID string. Hashed identifiers are tagged with the reserved
+ * UUID variant bits, so they can be told apart from canonical ones.
+ *
+ * Only canonical identifiers can be converted back to their UUID string without further information.
+ * Therefore, the original strings of hashed identifiers can be interned in a process-wide table
+ * (see Intern()) - and hashed identifiers are always sent in string form.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__tRuntimeId_h__
+#define __plugins__network_transport__tRuntimeId_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Runtime environment identifier
+/*!
+ * Compact 128 bit identifier of a runtime environment.
+ * Trivially copyable - comparisons are integer comparisons.
+ *
+ * Runtime UUIDs in canonical text form are converted to their 16 binary bytes.
+ * Any other UUID string is mapped to a 128 bit hash of the string.
+ */
+class tRuntimeId
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tRuntimeId() :
+    high(0),
+    low(0)
+  {}
+
+  tRuntimeId(uint64_t high, uint64_t low) :
+    high(high),
+    low(low)
+  {}
+
+  /*!
+   * Creates identifier from UUID string
+   * (does not lock or allocate - may be used on every message)
+   *
+   * \param uuid UUID of runtime environment - as string
+   */
+  explicit tRuntimeId(const std::string& uuid);
+
+  /*!
+   * Creates identifier from UUID string - and interns the string if the identifier is
+   * hashed (so that ToString() returns the original string).
+   * Locks the intern table in this case. Table entries are never removed - so this should
+   * only be called for UUIDs of connected runtime environments (not e.g. for every message).
+   *
+   * \param uuid UUID of runtime environment - as string
+   * \return Identifier
+   */
+  static tRuntimeId Intern(const std::string& uuid);
+
+  /*!
+   * \return Upper 64 bits of identifier
+   */
+  uint64_t GetHigh() const
+  {
+    return high;
+  }
+
+  /*!
+   * \return Lower 64 bits of identifier
+   */
+  uint64_t GetLow() const
+  {
+    return low;
+  }
+
+  /*!
+   * \return Hash value for hash tables
+   */
+  size_t Hash() const
+  {
+    return static_cast<size_t>(high ^ (low * 0x9E3779B97F4A7C15ULL));
+  }
+
+  /*!
+   * \return True if identifier was created from a UUID in canonical text form (and not hashed) - so that ToString() returns equivalent UUID
+   *         (canonical UUIDs with the reserved variant '111' are treated like hashed identifiers)
+   */
+  bool IsCanonical() const
+  {
+    return (low & cHASH_TAG_MASK) != cHASH_TAG_MASK;
+  }
+
+  /*!
+   * \return True if this is the null identifier (default-constructed)
+   */
+  bool IsNull() const
+  {
+    return high == 0 && low == 0;
+  }
+
+  /*!
+   * \return UUID string that this identifier was created from - in canonical UUID text form for canonical identifiers.
+   *         Hashed identifiers that were not interned in this process are also returned in canonical UUID text form.
+   */
+  std::string ToString() const;
+
+  bool operator==(const tRuntimeId& other) const
+  {
+    return high == other.high && low == other.low;
+  }
+
+  bool operator!=(const tRuntimeId& other) const
+  {
+    return !(*this == other);
+  }
+
+  bool operator<(const tRuntimeId& other) const
+  {
+    return high < other.high || (high == other.high && low < other.low);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Variant bits of hashed identifiers (reserved UUID variant '111') */
+  static constexpr uint64_t cHASH_TAG_MASK = 7ULL << 61;
+
+  /*! Upper and lower 64 bits of identifier */
+  uint64_t high, low;
+};
+
+
+inline rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tRuntimeId& id)
+{
+  stream.WriteLong(static_cast<int64_t>(id.GetHigh()));
+  stream.WriteLong(static_cast<int64_t>(id.GetLow()));
+  return stream;
+}
+
+inline rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tRuntimeId& id)
+{
+  uint64_t high = static_cast<uint64_t>(stream.ReadLong());
+  uint64_t low = static_cast<uint64_t>(stream.ReadLong());
+  id = tRuntimeId(high, low);
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+namespace std
+{
+
+template <>
+struct hash<finroc::network_transport::tRuntimeId>
+{
+  size_t operator()(const finroc::network_transport::tRuntimeId& id) const
+  {
+    return id.Hash();
+  }
+};
+
+}
+
+#endif
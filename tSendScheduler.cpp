@@ -0,0 +1,173 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tSendScheduler.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tSendScheduler.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <functional>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Queue size up to which stale entries are not removed (rebuilding small queues is not worth it) */
+static const size_t cMIN_COMPACTION_SIZE = 64;
+
+/*! Deadline of updates of ports without latency budget (they are served in enqueue order after ports with budget of the same priority) */
+static const tSendScheduler::tTimestamp cNO_DEADLINE = tSendScheduler::tTimestamp::max();
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tSendScheduler::tSendScheduler() :
+  mutex(),
+  queue(),
+  pending(),
+  next_sequence(0)
+{}
+
+void tSendScheduler::Clear()
+{
+  rrlib::thread::tLock lock(mutex);
+  queue = std::priority_queue<tEntry>();
+  pending.clear();
+}
+
+bool tSendScheduler::Dequeue(tHandle& handle)
+{
+  rrlib::thread::tLock lock(mutex);
+  while (!queue.empty())
+  {
+    tEntry entry = queue.top();
+    queue.pop();
+    auto it = pending.find(entry.handle);
+    if (it != pending.end() && it->second.sequence == entry.sequence)
+    {
+      pending.erase(it);
+      handle = entry.handle;
+      return true;
+    }
+  }
+  return false;
+}
+
+void tSendScheduler::Enqueue(tHandle handle, const tQualityOfService& quality_of_service, tTimestamp now)
+{
+  tEntry entry;
+  entry.handle = handle;
+  entry.priority = quality_of_service.priority;
+  entry.deadline = quality_of_service.latency_budget >= 0 ? now + std::chrono::milliseconds(quality_of_service.latency_budget) : cNO_DEADLINE;
+
+  rrlib::thread::tLock lock(mutex);
+  entry.sequence = next_sequence;
+  auto it = pending.find(handle);
+  if (it != pending.end())
+  {
+    // Value will be sent with pending update. A new entry is only required if
+    // the port's update is now more urgent (e.g. because its settings changed).
+    if (!(it->second < entry))
+    {
+      return;
+    }
+    it->second = entry;
+  }
+  else
+  {
+    pending.emplace(handle, entry);
+  }
+  next_sequence++;
+  queue.push(entry);
+  RemoveStaleEntriesIfNecessary();
+}
+
+void tSendScheduler::Remove(tHandle handle)
+{
+  rrlib::thread::tLock lock(mutex);
+  pending.erase(handle);
+  if (pending.empty())
+  {
+    queue = std::priority_queue<tEntry>();
+  }
+  RemoveStaleEntriesIfNecessary();
+}
+
+void tSendScheduler::RemoveStaleEntriesIfNecessary()
+{
+  if (queue.size() <= cMIN_COMPACTION_SIZE || queue.size() <= 2 * pending.size())
+  {
+    return;
+  }
+  std::vector<tEntry> entries;
+  entries.reserve(pending.size());
+  for (auto & entry : pending)
+  {
+    entries.push_back(entry.second);
+  }
+  queue = std::priority_queue<tEntry>(std::less<tEntry>(), std::move(entries));
+}
+
+size_t tSendScheduler::Size() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return pending.size();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
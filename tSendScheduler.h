@@ -0,0 +1,197 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tSendScheduler.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tSendScheduler
+ *
+ * \b tSendScheduler
+ *
+ * Queue of pending port updates to a single peer.
+ * Network transports enqueue handles of ports whose values changed and
+ * dequeue them when the connection is ready to send. Updates are served by
+ * priority class first, then by deadline (derived from the port's latency
+ * budget), then in enqueue order. Pending updates of the same port are
+ * coalesced - only the current value needs to be sent.
+ * This way, control values do not queue up behind bulk data.
+ *
+ * The loopback transport uses this queue for values that are published while
+ * the simulated link to a peer is busy.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__tSendScheduler_h__
+#define __plugins__network_transport__tSendScheduler_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <chrono>
+#include <queue>
+#include <unordered_map>
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tQualityOfService.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Priority-based queue of pending port updates
+/*!
+ * Priority-based queue of pending port updates to a single peer.
+ * Thread-safe: updates may be enqueued from port listeners while a
+ * sender thread dequeues them.
+ */
+class tSendScheduler
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef core::tFrameworkElement::tHandle tHandle;
+  typedef std::chrono::steady_clock::time_point tTimestamp;
+
+  tSendScheduler();
+
+  /*!
+   * Removes all pending updates
+   */
+  void Clear();
+
+  /*!
+   * Dequeues most urgent pending update
+   *
+   * \param handle Is set to handle of port to send value of
+   * \return False if there are no pending updates
+   */
+  bool Dequeue(tHandle& handle);
+
+  /*!
+   * \return Whether there are no pending updates
+   */
+  bool Empty() const
+  {
+    return Size() == 0;
+  }
+
+  /*!
+   * Enqueues update of port.
+   * If an update of this port is already pending, it is kept at the more
+   * urgent of the two positions.
+   *
+   * \param handle Handle of port whose value changed
+   * \param quality_of_service Quality of service settings of port
+   * \param now Current time (deadline is calculated from this and the latency budget)
+   */
+  void Enqueue(tHandle handle, const tQualityOfService& quality_of_service, tTimestamp now = std::chrono::steady_clock::now());
+
+  /*!
+   * Removes pending update of port (e.g. because port was deleted or disconnected)
+   *
+   * \param handle Handle of port
+   */
+  void Remove(tHandle handle);
+
+  /*!
+   * \return Number of pending updates
+   */
+  size_t Size() const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Entry in priority queue */
+  struct tEntry
+  {
+    tHandle handle;
+    tPortPriority priority;
+    tTimestamp deadline;
+    uint64_t sequence;
+
+    /*! Strict weak ordering for std::priority_queue: true if this entry is less urgent than 'other' */
+    bool operator<(const tEntry& other) const
+    {
+      if (priority != other.priority)
+      {
+        return priority < other.priority;
+      }
+      if (deadline != other.deadline)
+      {
+        return deadline > other.deadline;
+      }
+      return sequence > other.sequence;
+    }
+  };
+
+  /*! Mutex for all members */
+  mutable rrlib::thread::tMutex mutex;
+
+  /*!
+   * Pending updates.
+   * May contain stale entries of ports that were re-enqueued with higher urgency or removed.
+   * Those are skipped when dequeued - and removed when they make up more than half of the queue.
+   */
+  std::priority_queue<tEntry> queue;
+
+  /*! Handles of ports with pending updates -> their valid entry in queue */
+  std::unordered_map<tHandle, tEntry> pending;
+
+  /*! Sequence number of next entry */
+  uint64_t next_sequence;
+
+
+  /*!
+   * Rebuilds queue from valid entries if stale entries make up more than half of it
+   * (caller must hold mutex)
+   */
+  void RemoveStaleEntriesIfNecessary();
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,171 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tUpdateRateController.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tUpdateRateController.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Weight of new measurement in smoothed round-trip time (as in TCP) */
+static const double cROUND_TRIP_TIME_SMOOTHING = 0.125;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tUpdateRateController::tUpdateRateController(const tParameters& parameters) :
+  mutex(),
+  parameters(parameters),
+  current_interval(parameters.min_interval),
+  max_adapted_priority(parameters.max_adapted_priority),
+  default_min_net_update_time(parameters.default_min_net_update_time),
+  last_queue_depth(0),
+  min_round_trip_time(std::chrono::nanoseconds::zero()),
+  smoothed_round_trip_time(std::chrono::nanoseconds::zero())
+{
+  SetParameters(parameters);
+}
+
+int16_t tUpdateRateController::GetEffectiveMinNetUpdateTime(int16_t configured_min_net_update_time, const tQualityOfService& quality_of_service) const
+{
+  if (quality_of_service.priority > max_adapted_priority.load(std::memory_order_relaxed))
+  {
+    return configured_min_net_update_time;
+  }
+  int16_t interval = GetCurrentInterval();
+  int16_t port_interval = configured_min_net_update_time;
+  if (port_interval < 0)
+  {
+    port_interval = default_min_net_update_time.load(std::memory_order_relaxed);
+  }
+  return interval > port_interval ? interval : configured_min_net_update_time;
+}
+
+tUpdateRateController::tParameters tUpdateRateController::GetParameters() const
+{
+  rrlib::thread::tLock lock(mutex);
+  return parameters;
+}
+
+void tUpdateRateController::Reset()
+{
+  rrlib::thread::tLock lock(mutex);
+  current_interval.store(parameters.min_interval, std::memory_order_relaxed);
+  last_queue_depth = 0;
+  min_round_trip_time = std::chrono::nanoseconds::zero();
+  smoothed_round_trip_time = std::chrono::nanoseconds::zero();
+}
+
+void tUpdateRateController::SetParameters(const tParameters& new_parameters)
+{
+  rrlib::thread::tLock lock(mutex);
+  parameters = new_parameters;
+  parameters.max_interval = std::max(parameters.min_interval, parameters.max_interval);
+  max_adapted_priority.store(parameters.max_adapted_priority, std::memory_order_relaxed);
+  default_min_net_update_time.store(parameters.default_min_net_update_time, std::memory_order_relaxed);
+  int16_t interval = current_interval.load(std::memory_order_relaxed);
+  current_interval.store(std::min(parameters.max_interval, std::max(parameters.min_interval, interval)), std::memory_order_relaxed);
+}
+
+bool tUpdateRateController::Update(size_t queue_depth, std::chrono::nanoseconds round_trip_time)
+{
+  rrlib::thread::tLock lock(mutex);
+
+  // Round-trip time statistics
+  if (round_trip_time > std::chrono::nanoseconds::zero())
+  {
+    if (min_round_trip_time == std::chrono::nanoseconds::zero())
+    {
+      min_round_trip_time = round_trip_time;
+      smoothed_round_trip_time = round_trip_time;
+    }
+    else
+    {
+      min_round_trip_time = std::min(min_round_trip_time, round_trip_time);
+      smoothed_round_trip_time += std::chrono::duration_cast<std::chrono::nanoseconds>((round_trip_time - smoothed_round_trip_time) * cROUND_TRIP_TIME_SMOOTHING);
+    }
+  }
+
+  // Detect congestion
+  bool queue_growing = queue_depth > parameters.target_queue_depth && queue_depth >= last_queue_depth;
+  bool queuing_delay = min_round_trip_time > std::chrono::nanoseconds::zero() && smoothed_round_trip_time - min_round_trip_time > parameters.max_queuing_delay;
+  last_queue_depth = queue_depth;
+
+  // Adapt interval
+  int16_t interval = current_interval.load(std::memory_order_relaxed);
+  int new_interval = interval;
+  if (queue_growing || queuing_delay)
+  {
+    new_interval = std::max<int>(parameters.initial_backoff_interval, static_cast<int>(interval * parameters.backoff_factor));
+  }
+  else
+  {
+    new_interval = interval - parameters.recovery_step;
+  }
+  new_interval = std::min<int>(parameters.max_interval, std::max<int>(parameters.min_interval, new_interval));
+  current_interval.store(static_cast<int16_t>(new_interval), std::memory_order_relaxed);
+  return new_interval != interval;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,215 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tUpdateRateController.h
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tUpdateRateController
+ *
+ * \b tUpdateRateController
+ *
+ * Adapts the network update interval of lower-priority ports to the
+ * measured capacity of the link to a single peer.
+ *
+ * Network transports periodically feed the current send queue depth and
+ * measured round-trip times. If the queue grows beyond its target or the
+ * round-trip time rises clearly above its observed minimum (i.e. data queues
+ * up somewhere on the link), the effective update interval is increased
+ * multiplicatively. Otherwise, it is decreased additively
+ * (AIMD - as in TCP congestion control). The interval is kept within
+ * configured bounds.
+ *
+ * Effective intervals are per peer. They are meant to be applied by the
+ * transport when it decides whether to send a port value to this peer - and
+ * not in the port info sent to peers, as this is serialized once and shared
+ * by all peers (see tSerializedStructureCache).
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__network_transport__tUpdateRateController_h__
+#define __plugins__network_transport__tUpdateRateController_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tQualityOfService.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace network_transport
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Adaptive network update rate control
+/*!
+ * Adapts the network update interval of lower-priority ports to the
+ * measured capacity of the link to a single peer (AIMD).
+ *
+ * All methods are thread-safe. Effective intervals can be obtained without blocking.
+ */
+class tUpdateRateController
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Configuration of controller */
+  struct tParameters
+  {
+    /*! Bounds of effective update interval (in ms) */
+    int16_t min_interval, max_interval;
+
+    /*! Ports with this priority or lower are adapted (higher-priority ports keep their configured interval) */
+    tPortPriority max_adapted_priority;
+
+    /*! Send queue depth (in messages) above which a growing queue is considered congestion */
+    uint32_t target_queue_depth;
+
+    /*! Increase of smoothed round-trip time above its minimum that is considered congestion */
+    std::chrono::milliseconds max_queuing_delay;
+
+    /*! Factor that interval is multiplied with on congestion */
+    double backoff_factor;
+
+    /*! Interval (in ms) that is used on first congestion (when current interval is below) */
+    int16_t initial_backoff_interval;
+
+    /*! Amount (in ms) that interval is decreased by in each update without congestion */
+    int16_t recovery_step;
+
+    /*! Minimum network update interval (in ms) of ports that use the default (-1) - should be set to the transport's default */
+    int16_t default_min_net_update_time;
+
+    tParameters() :
+      min_interval(0),
+      max_interval(2000),
+      max_adapted_priority(tPortPriority::NORMAL),
+      target_queue_depth(8),
+      max_queuing_delay(50),
+      backoff_factor(2.0),
+      initial_backoff_interval(20),
+      recovery_step(10),
+      default_min_net_update_time(40)
+    {}
+  };
+
+  /*!
+   * \param parameters Configuration of controller (max_interval is raised to min_interval if it is lower)
+   */
+  tUpdateRateController(const tParameters& parameters = tParameters());
+
+  /*!
+   * \return Current adaptive update interval (in ms) - applied to ports with priority up to max_adapted_priority
+   */
+  int16_t GetCurrentInterval() const
+  {
+    return current_interval.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \param configured_min_net_update_time Minimum network update interval configured for port (-1 for default)
+   * \param quality_of_service Quality of service settings of port
+   * \return Effective minimum network update interval of port towards this peer
+   *         (configured_min_net_update_time - possibly -1 - if current interval is not larger than the port's interval)
+   */
+  int16_t GetEffectiveMinNetUpdateTime(int16_t configured_min_net_update_time, const tQualityOfService& quality_of_service) const;
+
+  /*!
+   * \return Configuration of controller
+   */
+  tParameters GetParameters() const;
+
+  /*!
+   * Resets controller to minimum interval and discards round-trip time history
+   * (e.g. after reconnect)
+   */
+  void Reset();
+
+  /*!
+   * \param parameters New configuration of controller (current interval is clamped to new bounds)
+   */
+  void SetParameters(const tParameters& parameters);
+
+  /*!
+   * Adapts update interval to current state of connection.
+   * Should be called periodically by network transport (e.g. every 100 ms).
+   *
+   * \param queue_depth Current number of messages in send queue to peer
+   * \param round_trip_time Most recently measured round-trip time to peer (zero if no new measurement is available)
+   * \return True if current interval changed
+   */
+  bool Update(size_t queue_depth, std::chrono::nanoseconds round_trip_time = std::chrono::nanoseconds::zero());
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Mutex for parameters */
+  mutable rrlib::thread::tMutex mutex;
+
+  /*! Configuration of controller */
+  tParameters parameters;
+
+  /*! Current adaptive update interval (in ms) */
+  std::atomic<int16_t> current_interval;
+
+  /*! Maximum priority of adapted ports (copy of parameter for lock-free access) */
+  std::atomic<tPortPriority> max_adapted_priority;
+
+  /*! Interval of ports that use the default (copy of parameter for lock-free access) */
+  std::atomic<int16_t> default_min_net_update_time;
+
+  /*! Send queue depth in last call to Update() */
+  size_t last_queue_depth;
+
+  /*! Minimum and smoothed round-trip time (zero if there was no measurement yet) */
+  std::chrono::nanoseconds min_round_trip_time, smoothed_round_trip_time;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,228 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tests/network_connections.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * Tests for tRuntimeId, tNetworkConnection and tNetworkConnections
+ * (in particular: serialization round trips).
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tNetworkConnections.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc::network_transport;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! UUID in canonical text form */
+static const std::string cCANONICAL_UUID = "123e4567-e89b-12d3-a456-426614174000";
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class TestNetworkConnections : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TestNetworkConnections);
+  RRLIB_UNIT_TESTS_ADD_TEST(RuntimeId);
+  RRLIB_UNIT_TESTS_ADD_TEST(UuidStrings);
+  RRLIB_UNIT_TESTS_ADD_TEST(BinaryRuntimeIds);
+  RRLIB_UNIT_TESTS_ADD_TEST(Order);
+  RRLIB_UNIT_TESTS_ADD_TEST(Duplicates);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  /*!
+   * \return Port handles of connections in the order they are iterated
+   */
+  static std::vector<finroc::core::tFrameworkElement::tHandle> GetHandles(const tNetworkConnections& connections)
+  {
+    std::vector<finroc::core::tFrameworkElement::tHandle> result;
+    for (auto it = connections.Begin(); it != connections.End(); ++it)
+    {
+      result.push_back(it->GetPortHandle());
+    }
+    return result;
+  }
+
+  /*!
+   * Serializes connection in string form and returns the UUID string that is sent
+   */
+  static std::string SerializedUuid(const tNetworkConnection& connection)
+  {
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    output_stream << connection;
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tDestinationEncoding encoding;
+    input_stream >> encoding;
+    RRLIB_UNIT_TESTS_ASSERT(encoding == tDestinationEncoding::UUID_AND_HANDLE);
+    return input_stream.ReadString();
+  }
+
+  /*!
+   * Serializes connection with specified encoding of UUIDs and deserializes it again
+   */
+  static tNetworkConnection RoundTrip(const tNetworkConnection& connection, bool binary_uuid)
+  {
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    connection.Serialize(output_stream, binary_uuid);
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tNetworkConnection result;
+    input_stream >> result;
+    RRLIB_UNIT_TESTS_ASSERT(!input_stream.MoreDataAvailable());
+    return result;
+  }
+
+  void RuntimeId()
+  {
+    tRuntimeId canonical(cCANONICAL_UUID);
+    RRLIB_UNIT_TESTS_ASSERT(canonical.IsCanonical());
+    RRLIB_UNIT_TESTS_EQUALITY(cCANONICAL_UUID, canonical.ToString());
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Canonical UUIDs are case-insensitive", canonical == tRuntimeId("123E4567-E89B-12D3-A456-426614174000"));
+
+    tRuntimeId hashed("localhost:4444");
+    RRLIB_UNIT_TESTS_ASSERT(!hashed.IsCanonical());
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Hashing must be deterministic", hashed == tRuntimeId("localhost:4444"));
+    RRLIB_UNIT_TESTS_ASSERT(hashed != tRuntimeId("localhost:4445"));
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("localhost:4444"), tRuntimeId::Intern("localhost:4444").ToString());
+  }
+
+  void UuidStrings()
+  {
+    // UUID strings are sent exactly as received - also by peers that did not intern them
+    const std::string uuids[] = { cCANONICAL_UUID, "123E4567-E89B-12D3-A456-426614174000", "not-interned-peer:4444" };
+    for (const std::string & uuid : uuids)
+    {
+      rrlib::serialization::tMemoryBuffer buffer;
+      rrlib::serialization::tOutputStream output_stream(buffer);
+      output_stream << tDestinationEncoding::UUID_AND_HANDLE << uuid << static_cast<finroc::core::tFrameworkElement::tHandle>(5) << false;
+      output_stream.Close();
+      rrlib::serialization::tInputStream input_stream(buffer);
+      tNetworkConnection connection;
+      input_stream >> connection;
+      RRLIB_UNIT_TESTS_ASSERT(connection.GetRuntimeId() == tRuntimeId(uuid));
+      RRLIB_UNIT_TESTS_EQUALITY(uuid, SerializedUuid(connection));
+      RRLIB_UNIT_TESTS_EQUALITY(uuid, SerializedUuid(tNetworkConnection(uuid, 5, false)));
+    }
+  }
+
+  void BinaryRuntimeIds()
+  {
+    const tNetworkConnection connections[] =
+    {
+      tNetworkConnection(cCANONICAL_UUID, 7, false),
+      tNetworkConnection("123E4567-E89B-12D3-A456-426614174000", 7, false),
+      tNetworkConnection("peer:4444", 8, true),  // hashed UUID (always sent as string)
+      tNetworkConnection(tRuntimeId(cCANONICAL_UUID), 9, true)
+    };
+    for (const tNetworkConnection & connection : connections)
+    {
+      for (bool binary_uuid : { false, true })
+      {
+        tNetworkConnection result = RoundTrip(connection, binary_uuid);
+        RRLIB_UNIT_TESTS_ASSERT(connection == result);
+        RRLIB_UNIT_TESTS_ASSERT(connection.GetRuntimeId() == result.GetRuntimeId());
+        RRLIB_UNIT_TESTS_EQUALITY(connection.GetPortHandle(), result.GetPortHandle());
+        RRLIB_UNIT_TESTS_EQUALITY(connection.IsDestinationSource(), result.IsDestinationSource());
+        bool binary_expected = binary_uuid && connection.GetRuntimeId().IsCanonical();
+        RRLIB_UNIT_TESTS_ASSERT(result.GetEncoding() == (binary_expected ? tDestinationEncoding::BINARY_UUID_AND_HANDLE : tDestinationEncoding::UUID_AND_HANDLE));
+      }
+    }
+  }
+
+  void Order()
+  {
+    tNetworkConnections connections;
+    for (finroc::core::tFrameworkElement::tHandle handle = 1; handle <= 6; handle++)
+    {
+      connections.Add(tNetworkConnection(handle % 2 ? "peer-a:4444" : "peer-b:4444", handle, false));
+    }
+    connections.Remove(tNetworkConnection("peer-b:4444", 2, false));
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Remove() must preserve order", GetHandles(connections) == std::vector<finroc::core::tFrameworkElement::tHandle>({ 1, 3, 4, 5, 6 }));
+    connections.RemoveAll(tRuntimeId("peer-a:4444"));
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("RemoveAll() must preserve order", GetHandles(connections) == std::vector<finroc::core::tFrameworkElement::tHandle>({ 4, 6 }));
+    connections.Add(tNetworkConnection("peer-a:4444", 1, false));
+
+    // Serialization order is order of addition
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    output_stream << connections;
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tNetworkConnections result;
+    input_stream >> result;
+    RRLIB_UNIT_TESTS_ASSERT(GetHandles(result) == std::vector<finroc::core::tFrameworkElement::tHandle>({ 4, 6, 1 }));
+  }
+
+  void Duplicates()
+  {
+    tNetworkConnection connection("peer:4444", 1, false);
+    tNetworkConnections connections;
+    connections.Add(connection);
+    connections.Add(tNetworkConnection("peer:4444", 1, false));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), connections.Count());
+
+    // Duplicates in streams (not created by any Finroc version) are ignored
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    output_stream.WriteInt(3);
+    output_stream << connection << tNetworkConnection("peer:4444", 2, false) << connection;
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tNetworkConnections result;
+    input_stream >> result;
+    RRLIB_UNIT_TESTS_ASSERT(GetHandles(result) == std::vector<finroc::core::tFrameworkElement::tHandle>({ 1, 2 }));
+    RRLIB_UNIT_TESTS_ASSERT(!input_stream.MoreDataAvailable());
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TestNetworkConnections);
@@ -0,0 +1,343 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tests/structure_changes.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * Tests for mirroring the structure of a remote runtime environment -
+ * in particular: applying structure changes to tRemoteStructureTable.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include "core/tRuntimeEnvironment.h"
+#include "plugins/data_ports/tInputPort.h"
+#include "plugins/data_ports/tOutputPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tProtocolCapabilities.h"
+#include "plugins/network_transport/structure_info/tRemoteStructureTable.h"
+#include "plugins/network_transport/structure_info/tStructureChangeBatcher.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc;
+using namespace finroc::network_transport;
+using namespace finroc::network_transport::structure_info;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class TestStructureChanges : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TestStructureChanges);
+  RRLIB_UNIT_TESTS_ADD_TEST(RemoteStructureTable);
+  RRLIB_UNIT_TESTS_ADD_TEST(ChangeBatch);
+  RRLIB_UNIT_TESTS_ADD_TEST(ChangeBatcher);
+  RRLIB_UNIT_TESTS_ADD_TEST(StructureFilter);
+  RRLIB_UNIT_TESTS_ADD_TEST(ChangeFilter);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  /*!
+   * Creates (uninitialized) group for test elements below runtime environment
+   * (to be deleted with ManagedDelete())
+   */
+  static core::tFrameworkElement* CreateTestGroup(const std::string& name)
+  {
+    return new core::tFrameworkElement(&core::tRuntimeEnvironment::GetInstance(), name);
+  }
+
+  /*!
+   * Serializes info on port (structure exchange level SHARED_PORTS) and adds it to table
+   */
+  static size_t AddToTable(tRemoteStructureTable& table, core::tAbstractPort& port)
+  {
+    rrlib::serialization::tMemoryBuffer buffer;
+    std::string string_buffer;
+    {
+      tStructureEncodingState encoding_state;
+      rrlib::serialization::tOutputStream output_stream(buffer);
+      tFrameworkElementInfo::Serialize(output_stream, port, tStructureExchange::SHARED_PORTS, string_buffer, encoding_state);
+      output_stream.Close();
+    }
+    tStructureEncodingState encoding_state;
+    rrlib::serialization::tInputStream input_stream(buffer);
+    size_t index = table.DeserializeElement(port.GetHandle(), input_stream, encoding_state);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Element info must be read completely", !input_stream.MoreDataAvailable());
+    return index;
+  }
+
+  /*!
+   * Serializes pending changes of batcher and applies them to table
+   */
+  static void ApplyBatch(tStructureChangeBatcher& batcher, tRemoteStructureTable& table)
+  {
+    rrlib::serialization::tMemoryBuffer buffer;
+    std::string string_buffer;
+    {
+      tStructureEncodingState encoding_state;
+      rrlib::serialization::tOutputStream output_stream(buffer);
+      batcher.SerializeBatch(output_stream, string_buffer, encoding_state);
+      output_stream.Close();
+    }
+    tStructureEncodingState encoding_state;
+    rrlib::serialization::tInputStream input_stream(buffer);
+    table.DeserializeChangeBatch(input_stream, encoding_state);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Batch must be read completely", !input_stream.MoreDataAvailable());
+  }
+
+  /*!
+   * \return Qualified link of port as sent with structure exchange level SHARED_PORTS (without first slash)
+   */
+  static std::string GetLink(core::tAbstractPort& port)
+  {
+    std::string link;
+    port.GetQualifiedLink(link, 0);
+    return link.substr(1);
+  }
+
+  void RemoteStructureTable()
+  {
+    core::tFrameworkElement* group = CreateTestGroup("TestRemoteStructureTable");
+    data_ports::tOutputPort<int> output("Output", group, core::tFrameworkElement::tFlag::SHARED);
+    data_ports::tInputPort<int> input("Input", group, core::tFrameworkElement::tFlag::SHARED);
+    data_ports::tInputPort<double> other_input("Other Input", group, core::tFrameworkElement::tFlag::SHARED);
+    group->Init();
+
+    tRemoteStructureTable table;
+    for (core::tAbstractPort * port : { output.GetWrapped(), input.GetWrapped(), other_input.GetWrapped() })
+    {
+      AddToTable(table, *port);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), table.Count());
+    for (core::tAbstractPort * port : { output.GetWrapped(), input.GetWrapped(), other_input.GetWrapped() })
+    {
+      size_t index = table.Find(port->GetHandle());
+      RRLIB_UNIT_TESTS_ASSERT(index != tRemoteStructureTable::cNOT_FOUND);
+      RRLIB_UNIT_TESTS_EQUALITY(port->GetHandle(), table.GetHandles()[index]);
+      RRLIB_UNIT_TESTS_ASSERT(port->GetDataType() == table.GetTypes()[index]);
+      RRLIB_UNIT_TESTS_EQUALITY(port->GetAllFlags().Raw(), table.GetFlags()[index].Raw());
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), table.GetLinkCount(index));
+      RRLIB_UNIT_TESTS_EQUALITY(GetLink(*port), std::string(table.GetLinkName(index, 0)));
+    }
+    std::vector<tRemoteStructureTable::tHandle> int_ports;
+    table.GetPortsOfType(rrlib::rtti::tDataType<int>(), int_ports);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), int_ports.size());
+
+    // Replacing and removing elements must keep lookup consistent
+    RRLIB_UNIT_TESTS_EQUALITY(table.Find(input.GetWrapped()->GetHandle()), AddToTable(table, *input.GetWrapped()));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), table.Count());
+    RRLIB_UNIT_TESTS_ASSERT(table.Remove(output.GetWrapped()->GetHandle()));
+    RRLIB_UNIT_TESTS_ASSERT(!table.Remove(output.GetWrapped()->GetHandle()));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(tRemoteStructureTable::cNOT_FOUND), table.Find(output.GetWrapped()->GetHandle()));
+    for (core::tAbstractPort * port : { input.GetWrapped(), other_input.GetWrapped() })
+    {
+      size_t index = table.Find(port->GetHandle());
+      RRLIB_UNIT_TESTS_ASSERT(index != tRemoteStructureTable::cNOT_FOUND);
+      RRLIB_UNIT_TESTS_ASSERT(port->GetDataType() == table.GetTypes()[index]);
+      RRLIB_UNIT_TESTS_EQUALITY(GetLink(*port), std::string(table.GetLinkName(index, 0)));
+    }
+
+    group->ManagedDelete();
+  }
+
+  void ChangeBatch()
+  {
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    tStructureChangeBatch::WriteChangeCount(output_stream, 3);
+    tStructureChangeBatch::WriteChange(output_stream, tStructureChangeType::ADD, 1);
+    tStructureChangeBatch::WriteChange(output_stream, tStructureChangeType::CHANGE, 2);
+    tStructureChangeBatch::WriteChange(output_stream, tStructureChangeType::REMOVE, 3);
+    output_stream.WriteByte(3);  // invalid change type
+    output_stream.WriteInt(4);
+    output_stream.WriteInt(-1);  // negative change count
+    output_stream.Close();
+
+    rrlib::serialization::tInputStream input_stream(buffer);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), tStructureChangeBatch::ReadChangeCount(input_stream));
+    const tStructureChangeType expected_types[] = { tStructureChangeType::ADD, tStructureChangeType::CHANGE, tStructureChangeType::REMOVE };
+    tStructureChangeType change_type;
+    tStructureChangeBatch::tHandle handle;
+    for (size_t i = 0; i < 3; i++)
+    {
+      RRLIB_UNIT_TESTS_ASSERT(tStructureChangeBatch::ReadChange(input_stream, change_type, handle));
+      RRLIB_UNIT_TESTS_ASSERT(expected_types[i] == change_type);
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<tStructureChangeBatch::tHandle>(i + 1), handle);
+    }
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Invalid change type must be detected", !tStructureChangeBatch::ReadChange(input_stream, change_type, handle));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(0), tStructureChangeBatch::ReadChangeCount(input_stream));
+  }
+
+  void ChangeBatcher()
+  {
+    tStructureChangeBatcher batcher(tStructureExchange::SHARED_PORTS);
+    tRemoteStructureTable table;
+    std::string string_buffer;
+    tStructureEncodingState serialize_state(tProtocolCapabilities::GetLocal().structure_encodings);
+    tStructureEncodingState deserialize_state(tProtocolCapabilities::GetLocal().structure_encodings);
+
+    // Ports are added
+    core::tFrameworkElement* group = CreateTestGroup("TestChangeBatcher");
+    data_ports::tOutputPort<int> output("Output", group, core::tFrameworkElement::tFlag::SHARED);
+    data_ports::tInputPort<int> input("Input", group, core::tFrameworkElement::tFlag::SHARED);
+    group->Init();
+    {
+      rrlib::serialization::tMemoryBuffer buffer;
+      rrlib::serialization::tOutputStream output_stream(buffer);
+      size_t change_count = batcher.SerializeBatch(output_stream, string_buffer, serialize_state);
+      output_stream.Close();
+      rrlib::serialization::tInputStream input_stream(buffer);
+      RRLIB_UNIT_TESTS_EQUALITY(change_count, table.DeserializeChangeBatch(input_stream, deserialize_state));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), table.Count());
+    for (core::tAbstractPort * port : { output.GetWrapped(), input.GetWrapped() })
+    {
+      size_t index = table.Find(port->GetHandle());
+      RRLIB_UNIT_TESTS_ASSERT(index != tRemoteStructureTable::cNOT_FOUND);
+      RRLIB_UNIT_TESTS_ASSERT(port->GetDataType() == table.GetTypes()[index]);
+      RRLIB_UNIT_TESTS_EQUALITY(port->GetAllFlags().Raw(), table.GetFlags()[index].Raw());
+    }
+
+    // Ports are removed
+    core::tFrameworkElement::tHandle output_handle = output.GetWrapped()->GetHandle();
+    group->ManagedDelete();
+    {
+      rrlib::serialization::tMemoryBuffer buffer;
+      rrlib::serialization::tOutputStream output_stream(buffer);
+      batcher.SerializeBatch(output_stream, string_buffer, serialize_state);
+      output_stream.Close();
+      rrlib::serialization::tInputStream input_stream(buffer);
+      table.DeserializeChangeBatch(input_stream, deserialize_state);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(0), table.Count());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(tRemoteStructureTable::cNOT_FOUND), table.Find(output_handle));
+  }
+
+  void StructureFilter()
+  {
+    tStructureFilter filter;
+    filter.roots = { 1, 2, 0x7FFFFFFF };
+    filter.required_flags = core::tFrameworkElement::tFlags(core::tFrameworkElement::tFlag::SHARED);
+    filter.excluded_flags = core::tFrameworkElement::tFlags(core::tFrameworkElement::tFlag::NETWORK_ELEMENT);
+    filter.type = rrlib::rtti::tDataType<int>();
+    filter.tag = "visible";
+
+    rrlib::serialization::tMemoryBuffer buffer;
+    {
+      rrlib::serialization::tOutputStream output_stream(buffer);
+      output_stream << filter << tStructureFilter();
+      output_stream.Close();
+    }
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tStructureFilter result;
+    input_stream >> result;
+    RRLIB_UNIT_TESTS_ASSERT(filter.roots == result.roots);
+    RRLIB_UNIT_TESTS_EQUALITY(filter.required_flags.Raw(), result.required_flags.Raw());
+    RRLIB_UNIT_TESTS_EQUALITY(filter.excluded_flags.Raw(), result.excluded_flags.Raw());
+    RRLIB_UNIT_TESTS_ASSERT(filter.type == result.type);
+    RRLIB_UNIT_TESTS_EQUALITY(filter.tag, result.tag);
+    input_stream >> result;
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Empty filter must remain empty", result.MatchesAll());
+
+    // Filters with too many roots are rejected
+    rrlib::serialization::tMemoryBuffer corrupt_buffer;
+    {
+      rrlib::serialization::tOutputStream output_stream(corrupt_buffer);
+      WriteVarInt(output_stream, tStructureFilter::cMAX_ROOTS + 1);
+      output_stream.Close();
+    }
+    rrlib::serialization::tInputStream corrupt_stream(corrupt_buffer);
+    RRLIB_UNIT_TESTS_EXCEPTION(corrupt_stream >> result, std::runtime_error);
+  }
+
+  void ChangeFilter()
+  {
+    core::tFrameworkElement* group = CreateTestGroup("TestChangeFilter");
+    data_ports::tOutputPort<int> output("Output", group, core::tFrameworkElement::tFlag::SHARED);
+    data_ports::tInputPort<double> input("Input", group, core::tFrameworkElement::tFlag::SHARED);
+    group->Init();
+    core::tFrameworkElement::tHandle output_handle = output.GetWrapped()->GetHandle();
+    core::tFrameworkElement::tHandle input_handle = input.GetWrapped()->GetHandle();
+
+    // Client knows all int ports
+    tStructureFilter int_filter;
+    int_filter.roots = { group->GetHandle() };
+    int_filter.type = rrlib::rtti::tDataType<int>();
+    tStructureChangeBatcher batcher(tStructureExchange::SHARED_PORTS, tStructureChangeBatcher::tParameters(), int_filter);
+    tRemoteStructureTable table;
+    {
+      rrlib::thread::tLock lock(core::tRuntimeEnvironment::GetInstance().GetStructureMutex());
+      batcher.SetClientElements({ output.GetWrapped(), input.GetWrapped() });
+    }
+    AddToTable(table, *output.GetWrapped());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(0), batcher.GetPendingChangeCount());
+
+    // Changing filter to double ports removes output and adds input
+    tStructureFilter double_filter = int_filter;
+    double_filter.type = rrlib::rtti::tDataType<double>();
+    batcher.SetFilter(double_filter);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), batcher.GetPendingChangeCount());
+    ApplyBatch(batcher, table);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), table.Count());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(tRemoteStructureTable::cNOT_FOUND), table.Find(output_handle));
+    RRLIB_UNIT_TESTS_ASSERT(table.Find(input_handle) != tRemoteStructureTable::cNOT_FOUND);
+
+    // Widening filter only adds elements the client has no info on
+    tStructureFilter group_filter;
+    group_filter.roots = { group->GetHandle() };
+    batcher.SetFilter(group_filter);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), batcher.GetPendingChangeCount());
+    ApplyBatch(batcher, table);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), table.Count());
+    batcher.SetFilter(group_filter);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(0), batcher.GetPendingChangeCount());
+
+    group->ManagedDelete();
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TestStructureChanges);
@@ -0,0 +1,317 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/network_transport/tests/structure_encoding.cpp
+ *
+ * \author  Finroc GbR
+ *
+ * \date    2026-10-16
+ *
+ * Round-trip tests for the optional structure encodings (tStructureEncodingFlag):
+ * everything that is serialized must deserialize to the same values.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <set>
+#include "rrlib/util/tUnitTestSuite.h"
+#include "core/tRuntimeEnvironment.h"
+#include "plugins/data_ports/tInputPort.h"
+#include "plugins/data_ports/tOutputPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/network_transport/tProtocolCapabilities.h"
+#include "plugins/network_transport/structure_info/tFrameworkElementInfo.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc;
+using namespace finroc::network_transport;
+using namespace finroc::network_transport::structure_info;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Number of connections in connection list test (more than the 254 supported by the original format) */
+static const size_t cMANY_CONNECTIONS = 300;
+
+/*! All combinations of optional encodings that affect tChangeablePortInfo */
+static const tStructureEncodingFlags cCHANGEABLE_INFO_ENCODINGS[] =
+{
+  tStructureEncodingFlags(),
+  tStructureEncodingFlags(tStructureEncodingFlag::COMPACT_FLAGS),
+  tStructureEncodingFlags(tStructureEncodingFlag::QOS_INFO),
+  tStructureEncodingFlag::COMPACT_FLAGS | tStructureEncodingFlag::QOS_INFO
+};
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class TestStructureEncoding : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TestStructureEncoding);
+  RRLIB_UNIT_TESTS_ADD_TEST(VarInt);
+  RRLIB_UNIT_TESTS_ADD_TEST(LinkFrontCoding);
+  RRLIB_UNIT_TESTS_ADD_TEST(ChangeablePortInfo);
+  RRLIB_UNIT_TESTS_ADD_TEST(ConnectionLists);
+  RRLIB_UNIT_TESTS_ADD_TEST(ProtocolCapabilities);
+  RRLIB_UNIT_TESTS_ADD_TEST(PriorityClamping);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  /*!
+   * Creates (uninitialized) group for test elements below runtime environment
+   * (to be deleted with ManagedDelete())
+   */
+  static core::tFrameworkElement* CreateTestGroup(const std::string& name)
+  {
+    return new core::tFrameworkElement(&core::tRuntimeEnvironment::GetInstance(), name);
+  }
+
+  /*!
+   * Serializes changeable info with specified encoding and deserializes it again
+   */
+  static tChangeablePortInfo RoundTrip(const tChangeablePortInfo& info, tStructureEncodingFlags encoding)
+  {
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    info.Serialize(output_stream, encoding);
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tChangeablePortInfo result;
+    result.Deserialize(input_stream, encoding);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Changeable info must be read completely", !input_stream.MoreDataAvailable());
+    return result;
+  }
+
+  void VarInt()
+  {
+    const uint64_t values[] = { 0, 1, 0x7F, 0x80, 0x3FFF, 0x4000, 0xFFFFFFFF, 0xFFFFFFFFFFFFFFFFULL };
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    for (uint64_t value : values)
+    {
+      WriteVarInt(output_stream, value);
+    }
+    output_stream.Close();
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Each byte must carry 7 bits of the value", static_cast<size_t>(1 + 1 + 1 + 2 + 2 + 3 + 5 + 10), buffer.GetSize());
+
+    rrlib::serialization::tInputStream input_stream(buffer);
+    for (uint64_t value : values)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(value, ReadVarInt(input_stream));
+    }
+  }
+
+  void LinkFrontCoding()
+  {
+    core::tFrameworkElement* group = CreateTestGroup("TestLinkFrontCoding");
+    core::tFrameworkElement* link_group = new core::tFrameworkElement(group, "Links");
+    std::vector<data_ports::tOutputPort<int>> ports;
+    for (size_t i = 0; i < 20; i++)
+    {
+      ports.emplace_back("Output " + std::to_string(i), group, core::tFrameworkElement::tFlag::SHARED);
+      ports.back().GetWrapped()->Link(*link_group, "Output " + std::to_string(i) + " Link");
+    }
+    group->Init();
+
+    // Serialize with original format and with front coding
+    rrlib::serialization::tMemoryBuffer plain_buffer, front_coded_buffer;
+    std::string string_buffer;
+    {
+      tStructureEncodingState plain_encoding, front_coding(tStructureEncodingFlag::LINK_FRONT_CODING);
+      rrlib::serialization::tOutputStream plain_stream(plain_buffer), front_coded_stream(front_coded_buffer);
+      for (auto & port : ports)
+      {
+        tFrameworkElementInfo::Serialize(plain_stream, *port.GetWrapped(), tStructureExchange::SHARED_PORTS, string_buffer, plain_encoding);
+        tFrameworkElementInfo::Serialize(front_coded_stream, *port.GetWrapped(), tStructureExchange::SHARED_PORTS, string_buffer, front_coding);
+      }
+      plain_stream.Close();
+      front_coded_stream.Close();
+    }
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Front coding must reduce size of similar links", front_coded_buffer.GetSize() < plain_buffer.GetSize());
+
+    // Both must deserialize to the same info
+    tStructureEncodingState plain_encoding, front_coding(tStructureEncodingFlag::LINK_FRONT_CODING);
+    rrlib::serialization::tInputStream plain_stream(plain_buffer), front_coded_stream(front_coded_buffer);
+    tFrameworkElementInfo plain_info, front_coded_info;
+    for (auto & port : ports)
+    {
+      plain_info.Deserialize(plain_stream, plain_encoding);
+      front_coded_info.Deserialize(front_coded_stream, front_coding);
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(port.GetWrapped()->GetLinkCount()), static_cast<int>(front_coded_info.link_count));
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(plain_info.link_count), static_cast<int>(front_coded_info.link_count));
+      for (size_t i = 0; i < plain_info.link_count; i++)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY(plain_info.links[i].name, front_coded_info.links[i].name);
+        RRLIB_UNIT_TESTS_EQUALITY(plain_info.links[i].unique, front_coded_info.links[i].unique);
+      }
+      RRLIB_UNIT_TESTS_ASSERT(port.GetWrapped()->GetDataType() == front_coded_info.type);
+      RRLIB_UNIT_TESTS_EQUALITY(port.GetWrapped()->GetAllFlags().Raw(), front_coded_info.changeable_info.flags.Raw());
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!front_coded_stream.MoreDataAvailable());
+
+    group->ManagedDelete();
+  }
+
+  void ChangeablePortInfo()
+  {
+    core::tFrameworkElement* group = CreateTestGroup("TestChangeablePortInfo");
+    data_ports::tInputPort<int> port("Input", group, core::tFrameworkElement::tFlag::SHARED);
+    group->Init();
+
+    tChangeablePortInfo default_port_info;
+    default_port_info.flags = port.GetWrapped()->GetAllFlags();
+    tChangeablePortInfo port_info = default_port_info;
+    port_info.strategy = 3;
+    port_info.min_net_update_time = 200;
+    port_info.quality_of_service = tQualityOfService(tPortPriority::REAL_TIME, 5);
+    tChangeablePortInfo element_info;
+    element_info.flags = group->GetAllFlags();
+    element_info.min_net_update_time = 0;
+
+    for (tStructureEncodingFlags encoding : cCHANGEABLE_INFO_ENCODINGS)
+    {
+      bool qos_info = encoding.Get(tStructureEncodingFlag::QOS_INFO);
+      for (const tChangeablePortInfo* info : { &default_port_info, &port_info })
+      {
+        tChangeablePortInfo result = RoundTrip(*info, encoding);
+        RRLIB_UNIT_TESTS_EQUALITY(info->flags.Raw(), result.flags.Raw());
+        RRLIB_UNIT_TESTS_EQUALITY(info->strategy, result.strategy);
+        RRLIB_UNIT_TESTS_EQUALITY(info->min_net_update_time, result.min_net_update_time);
+        tQualityOfService expected_qos = qos_info ? info->quality_of_service : tQualityOfService();
+        RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Priority must only be exchanged with QOS_INFO", expected_qos.priority == result.quality_of_service.priority);
+        RRLIB_UNIT_TESTS_EQUALITY(expected_qos.latency_budget, result.quality_of_service.latency_budget);
+      }
+
+      // with COMPACT_FLAGS, only first and last 8 bits of non-port flags are exchanged
+      tChangeablePortInfo result = RoundTrip(element_info, encoding);
+      uint32_t mask = encoding.Get(tStructureEncodingFlag::COMPACT_FLAGS) ? 0xFF0000FF : 0xFFFFFFFF;
+      RRLIB_UNIT_TESTS_EQUALITY(element_info.flags.Raw() & mask, result.flags.Raw());
+      RRLIB_UNIT_TESTS_EQUALITY(element_info.min_net_update_time, result.min_net_update_time);
+    }
+
+    group->ManagedDelete();
+  }
+
+  void ConnectionLists()
+  {
+    core::tFrameworkElement* group = CreateTestGroup("TestConnectionLists");
+    data_ports::tOutputPort<int> output("Output", group, core::tFrameworkElement::tFlag::SHARED);
+    std::vector<data_ports::tInputPort<int>> inputs;
+    for (size_t i = 0; i < cMANY_CONNECTIONS; i++)
+    {
+      inputs.emplace_back("Input " + std::to_string(i), group, core::tFrameworkElement::tFlag::SHARED);
+      output.ConnectTo(inputs.back());
+    }
+    group->Init();
+
+    rrlib::serialization::tMemoryBuffer buffer;
+    {
+      tStructureEncodingState encoding_state(tStructureEncodingFlag::CONNECTION_LISTS);
+      rrlib::serialization::tOutputStream output_stream(buffer);
+      tFrameworkElementInfo::SerializeConnections(output_stream, *output.GetWrapped(), encoding_state);
+      output_stream.Close();
+    }
+
+    // Format: [varint: n] n * [int: handle] [(n + 7) / 8 bytes: finstructed bitmap] [bool: network connections]
+    rrlib::serialization::tInputStream input_stream(buffer);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(cMANY_CONNECTIONS), ReadVarInt(input_stream));
+    std::set<core::tFrameworkElement::tHandle> expected_handles, handles;
+    for (auto & input : inputs)
+    {
+      expected_handles.insert(input.GetWrapped()->GetHandle());
+    }
+    for (size_t i = 0; i < cMANY_CONNECTIONS; i++)
+    {
+      handles.insert(input_stream.ReadInt());
+    }
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("All connections must be serialized", expected_handles == handles);
+    for (size_t i = 0; i < (cMANY_CONNECTIONS + 7) / 8; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("No connection is finstructed", 0, static_cast<int>(input_stream.ReadByte()));
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!input_stream.ReadBoolean());
+    RRLIB_UNIT_TESTS_ASSERT(!input_stream.MoreDataAvailable());
+
+    group->ManagedDelete();
+  }
+
+  void ProtocolCapabilities()
+  {
+    tProtocolCapabilities local = tProtocolCapabilities::GetLocal();
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    output_stream << local;
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tProtocolCapabilities result;
+    input_stream >> result;
+    RRLIB_UNIT_TESTS_EQUALITY(local.version, result.version);
+    RRLIB_UNIT_TESTS_EQUALITY(local.structure_encodings.Raw(), result.structure_encodings.Raw());
+
+    // Peers without capability exchange
+    tProtocolCapabilities negotiated = local.Negotiate(tProtocolCapabilities());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(0), negotiated.version);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint32_t>(0), negotiated.structure_encodings.Raw());
+
+    // Peer that supports a subset of encodings (and a newer version)
+    tProtocolCapabilities remote(tProtocolCapabilities::cCURRENT_VERSION + 1, tStructureEncodingFlag::LINK_FRONT_CODING | tStructureEncodingFlag::QOS_INFO);
+    negotiated = local.Negotiate(remote);
+    RRLIB_UNIT_TESTS_EQUALITY(local.version, negotiated.version);
+    RRLIB_UNIT_TESTS_EQUALITY((local.structure_encodings & remote.structure_encodings).Raw(), negotiated.structure_encodings.Raw());
+  }
+
+  void PriorityClamping()
+  {
+    RRLIB_UNIT_TESTS_ASSERT(tQualityOfService::ToPortPriority(static_cast<uint8_t>(tPortPriority::NORMAL)) == tPortPriority::NORMAL);
+    RRLIB_UNIT_TESTS_ASSERT(tQualityOfService::ToPortPriority(200) == tPortPriority::REAL_TIME);
+
+    // Priority byte from a peer with more priority classes
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output_stream(buffer);
+    output_stream << static_cast<uint32_t>(0) << static_cast<int16_t>(0) << static_cast<int16_t>(-1) << static_cast<uint8_t>(200) << static_cast<int16_t>(-1);
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(buffer);
+    tChangeablePortInfo info;
+    info.Deserialize(input_stream, tStructureEncodingFlags(tStructureEncodingFlag::QOS_INFO));
+    RRLIB_UNIT_TESTS_ASSERT(info.quality_of_service.priority == tPortPriority::REAL_TIME);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TestStructureEncoding);